@@ -38,6 +38,9 @@ public class LevelProgressTracker : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"Json",
+				"JsonUtilities",
+				"Projects",
 				"Slate",
 				"SlateCore",
 				"UMG",
@@ -46,6 +49,12 @@ public class LevelProgressTracker : ModuleRules
 			);
 		
 		
+		if (Target.bBuildEditor)
+		{
+			// Cook-time ordering of collection asset lists reads the target platform name.
+			PrivateIncludePathModuleNames.Add("TargetPlatform");
+		}
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -0,0 +1,313 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "AssetCollectionDataLPT.h"
+#include "Algo/IsSorted.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/ObjectSaveContext.h"
+
+namespace
+{
+	// Package order of one cook platform, shared by every collection saved in the cook.
+	struct FCookPackageOrderLPT
+	{
+		// Position in the open order logs the containers are laid out by.
+		TMap<FName, int32> ListedPackageOrder;
+
+		// Longest hard dependency chain below the package, for packages missing from the logs.
+		TMap<FName, int32> DependencyHeights;
+
+		// Timestamps of the logs the order was read from. FDateTime::MinValue() for a missing log.
+		FDateTime GameOpenOrderTimestamp;
+		FDateTime CookerOpenOrderTimestamp;
+	};
+
+	// Converts one FileOpenOrder line ("../../../Project/Content/Maps/Map.umap" 12) to a long package name.
+	bool ParseOpenOrderLine(const FString& Line, FName& OutPackageName)
+	{
+		FString FilePath = Line.TrimStartAndEnd();
+		if (FilePath.StartsWith(TEXT("\"")))
+		{
+			const int32 ClosingQuoteIndex = FilePath.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, 1);
+			if (ClosingQuoteIndex == INDEX_NONE)
+			{
+				return false;
+			}
+			FilePath = FilePath.Mid(1, ClosingQuoteIndex - 1);
+		}
+		else
+		{
+			int32 SpaceIndex = INDEX_NONE;
+			if (FilePath.FindChar(TEXT(' '), SpaceIndex))
+			{
+				FilePath.LeftInline(SpaceIndex);
+			}
+		}
+
+		if (FilePath.IsEmpty())
+		{
+			return false;
+		}
+
+		FString PackageName;
+		if (FPackageName::TryConvertFilenameToLongPackageName(FPaths::GetBaseFilename(FilePath, false), PackageName))
+		{
+			OutPackageName = FName(*PackageName);
+			return true;
+		}
+
+		// Logs recorded from a staged build are relative to its root, project content still maps to /Game.
+		FString ProjectRelativePath;
+		if (FilePath.Split(TEXT("/Content/"), nullptr, &ProjectRelativePath) && !FilePath.Contains(TEXT("/Plugins/")))
+		{
+			OutPackageName = FName(*(TEXT("/Game/") + FPaths::GetBaseFilename(ProjectRelativePath, false)));
+			return true;
+		}
+
+		return false;
+	}
+
+	void AppendOpenOrderLog(const FString& LogPath, TMap<FName, int32>& InOutPackageOrder)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *LogPath))
+		{
+			return;
+		}
+
+		for (const FString& Line : Lines)
+		{
+			FName PackageName;
+			if (ParseOpenOrderLine(Line, PackageName) && !InOutPackageOrder.Contains(PackageName))
+			{
+				InOutPackageOrder.Add(PackageName, InOutPackageOrder.Num());
+			}
+		}
+	}
+
+	FCookPackageOrderLPT& GetCookPackageOrder(const ITargetPlatform* TargetPlatform)
+	{
+		static TMap<FString, FCookPackageOrderLPT> PackageOrderByPlatform;
+
+		const FString PlatformName = TargetPlatform ? TargetPlatform->IniPlatformName() : FString(FPlatformProperties::IniPlatformName());
+		const FString OpenOrderFolder = FPaths::Combine(FPaths::ProjectDir(), TEXT("Build"), PlatformName, TEXT("FileOpenOrder"));
+		const FString GameOpenOrderPath = FPaths::Combine(OpenOrderFolder, TEXT("GameOpenOrder.log"));
+		const FString CookerOpenOrderPath = FPaths::Combine(OpenOrderFolder, TEXT("CookerOpenOrder.log"));
+
+		// The editor may cook several times in one session, with logs recorded in between. The cache is rebuilt when
+		// either log changes. Dependency heights are rebuilt with it, they only order packages missing from the logs.
+		const FDateTime GameOpenOrderTimestamp = IFileManager::Get().GetTimeStamp(*GameOpenOrderPath);
+		const FDateTime CookerOpenOrderTimestamp = IFileManager::Get().GetTimeStamp(*CookerOpenOrderPath);
+		if (FCookPackageOrderLPT* PackageOrder = PackageOrderByPlatform.Find(PlatformName))
+		{
+			if (PackageOrder->GameOpenOrderTimestamp == GameOpenOrderTimestamp && PackageOrder->CookerOpenOrderTimestamp == CookerOpenOrderTimestamp)
+			{
+				return *PackageOrder;
+			}
+		}
+
+		FCookPackageOrderLPT& PackageOrder = PackageOrderByPlatform.Add(PlatformName);
+		PackageOrder.GameOpenOrderTimestamp = GameOpenOrderTimestamp;
+		PackageOrder.CookerOpenOrderTimestamp = CookerOpenOrderTimestamp;
+
+		// Same precedence as the container writer: the game open order first, then the cooker open order.
+		AppendOpenOrderLog(GameOpenOrderPath, PackageOrder.ListedPackageOrder);
+		AppendOpenOrderLog(CookerOpenOrderPath, PackageOrder.ListedPackageOrder);
+
+		UE_LOG(LogTemp, Log, TEXT("LPT (GetCookPackageOrder): %d packages ordered by FileOpenOrder logs for platform '%s'."),
+			PackageOrder.ListedPackageOrder.Num(),
+			*PlatformName
+		);
+
+		return PackageOrder;
+	}
+
+	// Dependencies are loaded before the package that imports them, so lower heights come first.
+	int32 GetDependencyHeight(IAssetRegistry& Registry, const FName PackageName, TMap<FName, int32>& InOutHeights)
+	{
+		if (const int32* FoundHeight = InOutHeights.Find(PackageName))
+		{
+			return *FoundHeight;
+		}
+
+		// Added before the recursion, so dependency cycles end at this package.
+		InOutHeights.Add(PackageName, 0);
+
+		TArray<FName> Dependencies;
+		Registry.GetDependencies(
+			PackageName,
+			Dependencies,
+			UE::AssetRegistry::EDependencyCategory::Package,
+			UE::AssetRegistry::FDependencyQuery(UE::AssetRegistry::EDependencyQuery::Hard)
+		);
+
+		int32 Height = 0;
+		for (const FName DependencyPackageName : Dependencies)
+		{
+			if (!FPackageName::IsScriptPackage(DependencyPackageName.ToString()))
+			{
+				Height = FMath::Max(Height, GetDependencyHeight(Registry, DependencyPackageName, InOutHeights) + 1);
+			}
+		}
+
+		InOutHeights.Add(PackageName, Height);
+		return Height;
+	}
+}
+
+void UAssetCollectionDataLPT::PreSave(FObjectPreSaveContext SaveContext)
+{
+	// Cooked lists follow the container layout. The editor order is put back in PostSave, so a cook in the editor
+	// does not leave the editor asset in cook order.
+	if (SaveContext.IsCooking())
+	{
+		CookSaveEditorOrder = FEditorAssetOrderLPT{ AssetList, AssetCostWeights, AssetTiers, AssetLoadOrderKeys };
+		ApplyCookLoadOrder(SaveContext.GetTargetPlatform());
+	}
+	else
+	{
+		// Assets saved in cook order by older versions go back to path order.
+		RestorePathOrder();
+	}
+
+	Super::PreSave(SaveContext);
+}
+
+void UAssetCollectionDataLPT::PostSave(FObjectPostSaveContext SaveContext)
+{
+	Super::PostSave(SaveContext);
+
+	if (CookSaveEditorOrder.IsSet())
+	{
+		FEditorAssetOrderLPT& EditorOrder = CookSaveEditorOrder.GetValue();
+		AssetList = MoveTemp(EditorOrder.AssetList);
+		AssetCostWeights = MoveTemp(EditorOrder.AssetCostWeights);
+		AssetTiers = MoveTemp(EditorOrder.AssetTiers);
+		AssetLoadOrderKeys = MoveTemp(EditorOrder.AssetLoadOrderKeys);
+		CookSaveEditorOrder.Reset();
+	}
+}
+
+void UAssetCollectionDataLPT::ApplyCookLoadOrder(const ITargetPlatform* TargetPlatform)
+{
+	if (!GetDefault<ULevelProgressTrackerSettings>()->bOrderPreloadListsByIoLocality)
+	{
+		RestorePathOrder();
+		return;
+	}
+
+	FCookPackageOrderLPT& PackageOrder = GetCookPackageOrder(TargetPlatform);
+	IAssetRegistry& Registry = IAssetRegistry::GetChecked();
+
+	// Listed packages keep their log position. The rest follow all of them by dependency height, which only keeps
+	// dependencies ahead of their users and says nothing about where the packages sit in the containers.
+	const int32 UnlistedOrderBase = PackageOrder.ListedPackageOrder.Num();
+	TArray<int32> LoadOrderKeys;
+	LoadOrderKeys.Reserve(AssetList.Num());
+	for (const FSoftObjectPath& AssetPath : AssetList)
+	{
+		const FName PackageName = AssetPath.GetLongPackageFName();
+		if (const int32* ListedOrder = PackageOrder.ListedPackageOrder.Find(PackageName))
+		{
+			LoadOrderKeys.Add(*ListedOrder);
+		}
+		else
+		{
+			LoadOrderKeys.Add(UnlistedOrderBase + GetDependencyHeight(Registry, PackageName, PackageOrder.DependencyHeights));
+		}
+	}
+
+	SortAssetListByLoadOrder(MoveTemp(LoadOrderKeys));
+}
+
+void UAssetCollectionDataLPT::RestorePathOrder()
+{
+	if (AssetLoadOrderKeys.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<int32> LoadOrderKeys;
+	LoadOrderKeys.SetNumZeroed(AssetList.Num());
+	SortAssetListByLoadOrder(MoveTemp(LoadOrderKeys));
+	AssetLoadOrderKeys.Reset();
+}
+
+void UAssetCollectionDataLPT::SortAssetListByLoadOrder(TArray<int32>&& LoadOrderKeys)
+{
+	check(LoadOrderKeys.Num() == AssetList.Num());
+
+	TArray<int32> SortedIndices;
+	SortedIndices.Reserve(AssetList.Num());
+	for (int32 AssetIndex = 0; AssetIndex < AssetList.Num(); ++AssetIndex)
+	{
+		SortedIndices.Add(AssetIndex);
+	}
+
+	SortedIndices.Sort([this, &LoadOrderKeys](const int32 A, const int32 B)
+	{
+		return AssetOrderLess(LoadOrderKeys[A], AssetList[A], LoadOrderKeys[B], AssetList[B]);
+	});
+
+	// Weights and tiers are permuted only where they are generated for the whole list.
+	const bool bHasCostWeights = AssetCostWeights.Num() == AssetList.Num();
+	const bool bHasTiers = AssetTiers.Num() == AssetList.Num();
+
+	TArray<FSoftObjectPath> SortedAssetList;
+	TArray<int64> SortedCostWeights;
+	TArray<ELPTAssetPriorityTier> SortedTiers;
+	TArray<int32> SortedLoadOrderKeys;
+	SortedAssetList.Reserve(SortedIndices.Num());
+	SortedCostWeights.Reserve(bHasCostWeights ? SortedIndices.Num() : 0);
+	SortedTiers.Reserve(bHasTiers ? SortedIndices.Num() : 0);
+	SortedLoadOrderKeys.Reserve(SortedIndices.Num());
+	for (const int32 AssetIndex : SortedIndices)
+	{
+		SortedAssetList.Add(AssetList[AssetIndex]);
+		SortedLoadOrderKeys.Add(LoadOrderKeys[AssetIndex]);
+		if (bHasCostWeights)
+		{
+			SortedCostWeights.Add(AssetCostWeights[AssetIndex]);
+		}
+		if (bHasTiers)
+		{
+			SortedTiers.Add(AssetTiers[AssetIndex]);
+		}
+	}
+
+	AssetList = MoveTemp(SortedAssetList);
+	AssetLoadOrderKeys = MoveTemp(SortedLoadOrderKeys);
+	if (bHasCostWeights)
+	{
+		AssetCostWeights = MoveTemp(SortedCostWeights);
+	}
+	if (bHasTiers)
+	{
+		AssetTiers = MoveTemp(SortedTiers);
+	}
+}
+#endif
+
+bool UAssetCollectionDataLPT::IsAssetListSorted() const
+{
+	if (!HasAssetLoadOrder())
+	{
+		return Algo::IsSorted(AssetList, &UAssetCollectionDataLPT::AssetPathLess);
+	}
+
+	for (int32 AssetIndex = 1; AssetIndex < AssetList.Num(); ++AssetIndex)
+	{
+		if (AssetOrderLess(AssetLoadOrderKeys[AssetIndex], AssetList[AssetIndex], AssetLoadOrderKeys[AssetIndex - 1], AssetList[AssetIndex - 1]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -11,6 +11,13 @@ FLPTFilterSettings UAssetFilterSettingsLPT::ToFilterSettings() const
 	Result.FolderRules = FolderRules;
 	Result.bUseChunkedPreload = bUseChunkedPreload;
 	Result.PreloadChunkSize = FMath::Max(1, PreloadChunkSize);
+	Result.bUseAdaptiveChunkSize = bUseAdaptiveChunkSize;
+	Result.MinAdaptiveChunkSize = FMath::Max(1, MinAdaptiveChunkSize);
+	Result.MaxAdaptiveChunkSize = FMath::Max(Result.MinAdaptiveChunkSize, MaxAdaptiveChunkSize);
+	Result.TargetChunkLoadTime = FMath::Max(0.01f, TargetChunkLoadTime);
+	Result.MaxChunksInFlight = FMath::Max(1, MaxChunksInFlight);
+	Result.PreloadBackend = PreloadBackend;
+	Result.AssetTierRules = AssetTierRules;
 	Result.bAllowWorldPartitionAutoScan = bAllowWorldPartitionAutoScan;
 	Result.bAllowWorldPartitionUnscopedAutoScan = bAllowWorldPartitionUnscopedAutoScan;
 	return Result;
@@ -29,5 +36,11 @@ void UAssetFilterSettingsLPT::InitializeDefaultsFromProjectSettings(const ULevel
 	AssetClassFilter = Defaults.AssetClassFilter;
 	bUseChunkedPreload = Defaults.bUseChunkedPreload;
 	PreloadChunkSize = Defaults.PreloadChunkSize;
+	bUseAdaptiveChunkSize = Defaults.bUseAdaptiveChunkSize;
+	MinAdaptiveChunkSize = Defaults.MinAdaptiveChunkSize;
+	MaxAdaptiveChunkSize = Defaults.MaxAdaptiveChunkSize;
+	TargetChunkLoadTime = Defaults.TargetChunkLoadTime;
+	MaxChunksInFlight = Defaults.MaxChunksInFlight;
+	AssetTierRules = Defaults.AssetTierRules;
 	bAllowWorldPartitionUnscopedAutoScan = Defaults.bAllowWorldPartitionUnscopedAutoScan;
 }
@@ -2,6 +2,7 @@
 
 #include "LevelPreloadAssetFilter.h"
 #include "SettingsLPT.h"
+#include "Misc/Paths.h"
 
 
 namespace LevelPreloadAssetFilterPrivate
@@ -289,3 +290,21 @@ bool ULevelPreloadAssetFilter::ResolveDatabaseAssetPath(
 	return Settings->ResolveDatabaseAssetPaths(DatabaseFolderLongPath, OutDatabasePackagePath, OutDatabaseObjectPath);
 }
 
+FString ULevelPreloadAssetFilter::GetLearnedAssetsFilePath(const FString& LevelPackagePath)
+{
+	FString FileName = LevelPackagePath;
+	FileName.RemoveFromStart(TEXT("/"));
+	FileName.ReplaceCharInline(TEXT('/'), TEXT('_'));
+
+	return FPaths::ProjectSavedDir() / TEXT("LPT") / TEXT("Learned") / (FileName + TEXT(".json"));
+}
+
+FString ULevelPreloadAssetFilter::GetOverfetchReportFilePath(const FString& LevelPackagePath, const FString& Timestamp)
+{
+	FString FileName = LevelPackagePath;
+	FileName.RemoveFromStart(TEXT("/"));
+	FileName.ReplaceCharInline(TEXT('/'), TEXT('_'));
+
+	return FPaths::ProjectSavedDir() / TEXT("LPT") / TEXT("Overfetch") / FString::Printf(TEXT("%s_%s.json"), *FileName, *Timestamp);
+}
+
@@ -1,43 +1,184 @@
 // Pavel Gornostaev <https://github.com/Pavreally>
 
 #include "LevelPreloadDatabaseLPT.h"
+#include "PreloadSelectionLPT.h"
+#include "SubsytemLPT.h"
+#include "UObject/ObjectSaveContext.h"
 
-const FLevelPreloadEntryLPT* ULevelPreloadDatabaseLPT::FindEntryByLevel(const TSoftObjectPtr<UWorld>& Level) const
+#if WITH_EDITOR
+#include "Cook/CookDependency.h"
+#include "Cook/CookEvents.h"
+#endif
+
+void FLevelRuntimeRecordLPT::CopyChunkSettingsFrom(const FLPTFilterSettings& FilterSettings)
 {
-	const FSoftObjectPath LevelPath = Level.ToSoftObjectPath();
-	if (!LevelPath.IsValid())
+	bUseChunkedPreload = FilterSettings.bUseChunkedPreload;
+	PreloadChunkSize = FilterSettings.PreloadChunkSize;
+	bUseAdaptiveChunkSize = FilterSettings.bUseAdaptiveChunkSize;
+	MinAdaptiveChunkSize = FilterSettings.MinAdaptiveChunkSize;
+	MaxAdaptiveChunkSize = FilterSettings.MaxAdaptiveChunkSize;
+	TargetChunkLoadTime = FilterSettings.TargetChunkLoadTime;
+	MaxChunksInFlight = FilterSettings.MaxChunksInFlight;
+	PreloadBackend = FilterSettings.PreloadBackend;
+}
+
+void FLevelRuntimeRecordLPT::CopyChunkSettingsTo(FLPTFilterSettings& OutFilterSettings) const
+{
+	OutFilterSettings.bUseChunkedPreload = bUseChunkedPreload;
+	OutFilterSettings.PreloadChunkSize = PreloadChunkSize;
+	OutFilterSettings.bUseAdaptiveChunkSize = bUseAdaptiveChunkSize;
+	OutFilterSettings.MinAdaptiveChunkSize = MinAdaptiveChunkSize;
+	OutFilterSettings.MaxAdaptiveChunkSize = MaxAdaptiveChunkSize;
+	OutFilterSettings.TargetChunkLoadTime = TargetChunkLoadTime;
+	OutFilterSettings.MaxChunksInFlight = MaxChunksInFlight;
+	OutFilterSettings.PreloadBackend = PreloadBackend;
+}
+
+void ULevelPreloadDatabaseLPT::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildLevelIndex();
+}
+
+#if WITH_EDITOR
+void ULevelPreloadDatabaseLPT::PreSave(FObjectPreSaveContext SaveContext)
+{
+	// Baking loads every filter settings and collection asset, so it is done for cooked packages only. Editor saves
+	// drop the records, a record left by a cook in the editor would go stale with the next collection edit.
+	for (FLevelPreloadEntryLPT& Entry : Levels)
 	{
-		return nullptr;
+		if (SaveContext.IsCooking())
+		{
+			BakeRuntimeRecord(Entry, SaveContext.GetTargetPlatform());
+		}
+		else
+		{
+			Entry.RuntimeRecord = FLevelRuntimeRecordLPT();
+		}
 	}
 
+	Super::PreSave(SaveContext);
+}
+
+void ULevelPreloadDatabaseLPT::OnCookEvent(UE::Cook::ECookEvent CookEvent, UE::Cook::FCookEventContext& CookContext)
+{
+	Super::OnCookEvent(CookEvent, CookContext);
+
+	// Runtime records are baked from the collections and filter settings. Declaring their packages as build
+	// dependencies makes an incremental cook recook the database whenever one of them changes, so a cooked record
+	// and its merged lists always match the cooked collections.
+	if (CookEvent != UE::Cook::ECookEvent::PlatformCookDependencies || !CookContext.IsCooking())
+	{
+		return;
+	}
+
+	TSet<FName> DependencyPackageNames;
 	for (const FLevelPreloadEntryLPT& Entry : Levels)
 	{
-		if (Entry.Level.ToSoftObjectPath() == LevelPath)
+		for (const TSoftObjectPtr<UAssetCollectionDataLPT>& CollectionRef : Entry.Collections)
+		{
+			const FName CollectionPackageName = CollectionRef.ToSoftObjectPath().GetLongPackageFName();
+			if (!CollectionPackageName.IsNone())
+			{
+				DependencyPackageNames.Add(CollectionPackageName);
+			}
+		}
+
+		const FName FilterSettingsPackageName = Entry.FilterSettings.ToSoftObjectPath().GetLongPackageFName();
+		if (!FilterSettingsPackageName.IsNone())
 		{
-			return &Entry;
+			DependencyPackageNames.Add(FilterSettingsPackageName);
 		}
 	}
 
-	return nullptr;
+	for (const FName DependencyPackageName : DependencyPackageNames)
+	{
+		CookContext.AddLoadBuildDependency(UE::Cook::FCookDependency::Package(DependencyPackageName));
+	}
 }
 
-FLevelPreloadEntryLPT* ULevelPreloadDatabaseLPT::FindEntryByLevel(const TSoftObjectPtr<UWorld>& Level)
+void ULevelPreloadDatabaseLPT::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	RebuildLevelIndex();
+}
+#endif
+
+void ULevelPreloadDatabaseLPT::RebuildLevelIndex() const
+{
+	LevelIndexByPackage.Reset();
+	LevelIndexByPackage.Reserve(Levels.Num());
+	bHasDuplicateEntries = false;
+
+	for (int32 Index = 0; Index < Levels.Num(); ++Index)
+	{
+		const FSoftObjectPath LevelPath = Levels[Index].Level.ToSoftObjectPath();
+		if (!LevelPath.IsValid())
+		{
+			continue;
+		}
+
+		const FName PackageName = LevelPath.GetLongPackageFName();
+		if (LevelIndexByPackage.Contains(PackageName))
+		{
+			bHasDuplicateEntries = true;
+			continue;
+		}
+
+		LevelIndexByPackage.Add(PackageName, Index);
+	}
+
+	IndexedLevelCount = Levels.Num();
+}
+
+int32 ULevelPreloadDatabaseLPT::FindEntryIndex(const FSoftObjectPath& LevelPath) const
 {
-	const FSoftObjectPath LevelPath = Level.ToSoftObjectPath();
 	if (!LevelPath.IsValid())
 	{
-		return nullptr;
+		return INDEX_NONE;
 	}
 
-	for (FLevelPreloadEntryLPT& Entry : Levels)
+	if (IndexedLevelCount != Levels.Num())
+	{
+		RebuildLevelIndex();
+	}
+
+	const FName PackageName = LevelPath.GetLongPackageFName();
+	const int32* FoundIndex = LevelIndexByPackage.Find(PackageName);
+	if (FoundIndex && Levels.IsValidIndex(*FoundIndex) && Levels[*FoundIndex].Level.ToSoftObjectPath() == LevelPath)
 	{
-		if (Entry.Level.ToSoftObjectPath() == LevelPath)
+		return *FoundIndex;
+	}
+
+	// Stale index entry, Levels was reordered or edited in place without a rebuild.
+	if (FoundIndex)
+	{
+		RebuildLevelIndex();
+
+		FoundIndex = LevelIndexByPackage.Find(PackageName);
+		if (FoundIndex && Levels[*FoundIndex].Level.ToSoftObjectPath() == LevelPath)
 		{
-			return &Entry;
+			return *FoundIndex;
 		}
 	}
 
-	return nullptr;
+	return INDEX_NONE;
+}
+
+const FLevelPreloadEntryLPT* ULevelPreloadDatabaseLPT::FindEntryByLevel(const TSoftObjectPtr<UWorld>& Level) const
+{
+	const int32 EntryIndex = FindEntryIndex(Level.ToSoftObjectPath());
+
+	return EntryIndex != INDEX_NONE ? &Levels[EntryIndex] : nullptr;
+}
+
+FLevelPreloadEntryLPT* ULevelPreloadDatabaseLPT::FindEntryByLevel(const TSoftObjectPtr<UWorld>& Level)
+{
+	const int32 EntryIndex = FindEntryIndex(Level.ToSoftObjectPath());
+
+	return EntryIndex != INDEX_NONE ? &Levels[EntryIndex] : nullptr;
 }
 
 FLevelPreloadEntryLPT* ULevelPreloadDatabaseLPT::FindOrAddEntryByLevel(const TSoftObjectPtr<UWorld>& Level, bool& bWasAdded)
@@ -50,35 +191,21 @@ FLevelPreloadEntryLPT* ULevelPreloadDatabaseLPT::FindOrAddEntryByLevel(const TSo
 		return nullptr;
 	}
 
-	int32 PrimaryIndex = INDEX_NONE;
-	TArray<int32> DuplicateIndices;
-
-	for (int32 Index = 0; Index < Levels.Num(); ++Index)
+	if (IndexedLevelCount != Levels.Num())
 	{
-		if (Levels[Index].Level.ToSoftObjectPath() != LevelPath)
-		{
-			continue;
-		}
-
-		if (PrimaryIndex == INDEX_NONE)
-		{
-			PrimaryIndex = Index;
-		}
-		else
-		{
-			DuplicateIndices.Add(Index);
-		}
+		RebuildLevelIndex();
 	}
 
-	if (PrimaryIndex != INDEX_NONE)
+	if (bHasDuplicateEntries)
 	{
-		for (int32 DupArrayIndex = DuplicateIndices.Num() - 1; DupArrayIndex >= 0; --DupArrayIndex)
-		{
-			Levels.RemoveAt(DuplicateIndices[DupArrayIndex]);
-		}
+		RemoveDuplicateEntries();
+	}
 
-		DeduplicateCollections(Levels[PrimaryIndex]);
-		return &Levels[PrimaryIndex];
+	const int32 ExistingIndex = FindEntryIndex(LevelPath);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		DeduplicateCollections(Levels[ExistingIndex]);
+		return &Levels[ExistingIndex];
 	}
 
 	const int32 NewEntryIndex = Levels.AddDefaulted();
@@ -87,9 +214,36 @@ FLevelPreloadEntryLPT* ULevelPreloadDatabaseLPT::FindOrAddEntryByLevel(const TSo
 	DeduplicateCollections(NewEntry);
 	bWasAdded = true;
 
+	// Keep the index in sync without a full rebuild.
+	LevelIndexByPackage.Add(LevelPath.GetLongPackageFName(), NewEntryIndex);
+	IndexedLevelCount = Levels.Num();
+
 	return &NewEntry;
 }
 
+void ULevelPreloadDatabaseLPT::RemoveDuplicateEntries()
+{
+	TSet<FName> SeenPackages;
+	SeenPackages.Reserve(Levels.Num());
+
+	Levels.RemoveAll([&SeenPackages](const FLevelPreloadEntryLPT& Entry)
+	{
+		const FSoftObjectPath LevelPath = Entry.Level.ToSoftObjectPath();
+		if (!LevelPath.IsValid())
+		{
+			return false;
+		}
+
+		bool bAlreadySeen = false;
+		SeenPackages.Add(LevelPath.GetLongPackageFName(), &bAlreadySeen);
+
+		return bAlreadySeen;
+	});
+
+	// Removal shifts indices, so the lookup is rebuilt once for the whole compaction.
+	RebuildLevelIndex();
+}
+
 void ULevelPreloadDatabaseLPT::DeduplicateCollections(FLevelPreloadEntryLPT& Entry)
 {
 	TSet<FSoftObjectPath> UniqueCollectionPaths;
@@ -110,3 +264,92 @@ void ULevelPreloadDatabaseLPT::DeduplicateCollections(FLevelPreloadEntryLPT& Ent
 
 	Entry.Collections = MoveTemp(DeduplicatedCollections);
 }
+
+#if WITH_EDITOR
+void ULevelPreloadDatabaseLPT::BakeRuntimeRecord(FLevelPreloadEntryLPT& Entry, const ITargetPlatform* CookTargetPlatform)
+{
+	FLevelRuntimeRecordLPT& Record = Entry.RuntimeRecord;
+	Record = FLevelRuntimeRecordLPT();
+
+	const UAssetFilterSettingsLPT* FilterSettingsAsset = Entry.FilterSettings.LoadSynchronous();
+	if (FilterSettingsAsset)
+	{
+		Record.CopyChunkSettingsFrom(FilterSettingsAsset->ToFilterSettings());
+	}
+
+	// Collections the records and merged lists are built from, by path.
+	TMap<FSoftObjectPath, UAssetCollectionDataLPT*> BakeCollectionAssets;
+
+	Record.Collections.Reserve(Entry.Collections.Num());
+	for (const TSoftObjectPtr<UAssetCollectionDataLPT>& CollectionRef : Entry.Collections)
+	{
+		// Collections that fail to load are skipped by runtime selection anyway.
+		UAssetCollectionDataLPT* CollectionAsset = CollectionRef.LoadSynchronous();
+		if (!CollectionAsset)
+		{
+			continue;
+		}
+
+		// The database may be cooked before or after its collections. Merged lists are built from cook-ordered copies,
+		// so they match the cooked collections while the editor assets keep their order.
+		if (CookTargetPlatform)
+		{
+			CollectionAsset = DuplicateObject<UAssetCollectionDataLPT>(CollectionAsset, GetTransientPackage());
+			CollectionAsset->ApplyCookLoadOrder(CookTargetPlatform);
+		}
+		BakeCollectionAssets.Add(CollectionRef.ToSoftObjectPath(), CollectionAsset);
+
+		FLevelCollectionRecordLPT& CollectionRecord = Record.Collections.AddDefaulted_GetRef();
+		CollectionRecord.Collection = CollectionRef;
+		CollectionRecord.CollectionKey = CollectionAsset->CollectionKey;
+		CollectionRecord.GroupTags = CollectionAsset->GroupTags;
+		CollectionRecord.AssetCount = CollectionAsset->AssetList.Num();
+		CollectionRecord.CollectionContentHash = CollectionAsset->CollectionContentHash;
+	}
+
+	Record.bBaked = true;
+
+	// Default selection first, then the declared combinations. Combinations that select the same collections share one list.
+	TArray<FLPTLoadOptions> Selections;
+	Selections.AddDefaulted();
+	if (FilterSettingsAsset)
+	{
+		for (const FLPTPrecomputedSelectionLPT& PrecomputedSelection : FilterSettingsAsset->PrecomputedSelections)
+		{
+			FLPTLoadOptions& Selection = Selections.AddDefaulted_GetRef();
+			Selection.CollectionKeys = PrecomputedSelection.CollectionKeys;
+			Selection.GroupTags = PrecomputedSelection.GroupTags;
+		}
+	}
+
+	for (const FLPTLoadOptions& Selection : Selections)
+	{
+		TArray<FSoftObjectPath> CollectionPaths;
+		PreloadSelectionLPT::SelectCollectionPathsForLoad(Entry, Selection, CollectionPaths);
+		if (CollectionPaths.IsEmpty() || PreloadSelectionLPT::FindMergedList(Entry, CollectionPaths))
+		{
+			continue;
+		}
+
+		FLevelMergedListLPT& MergedList = Record.MergedLists.AddDefaulted_GetRef();
+		MergedList.Collections = CollectionPaths;
+
+		// Collections were loaded above, the merge is the one runtime uses when no list matches.
+		TArray<UAssetCollectionDataLPT*> CollectionAssets;
+		MergedList.bInLoadOrder = true;
+		for (const FSoftObjectPath& CollectionPath : CollectionPaths)
+		{
+			if (UAssetCollectionDataLPT* CollectionAsset = BakeCollectionAssets.FindRef(CollectionPath))
+			{
+				CollectionAssets.Add(CollectionAsset);
+				MergedList.CollectionKeys.Add(CollectionAsset->CollectionKey);
+				MergedList.bPinResident |= CollectionAsset->bPinResident;
+				MergedList.bInLoadOrder &= CollectionAsset->HasAssetLoadOrder();
+			}
+		}
+		MergedList.bInLoadOrder &= !CollectionAssets.IsEmpty();
+
+		PreloadSelectionLPT::MergeCollectionAssetLists(CollectionAssets, MergedList.AssetList, MergedList.AssetCostWeights, MergedList.AssetTiers);
+	}
+}
+#endif
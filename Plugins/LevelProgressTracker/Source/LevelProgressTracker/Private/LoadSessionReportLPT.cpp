@@ -0,0 +1,43 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "LoadSessionReportLPT.h"
+#include "HAL/FileManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+
+FString ULPTLoadSessionReport::ToJsonString() const
+{
+	FString JsonText;
+	FJsonObjectConverter::UStructToJsonObjectString(Data, JsonText);
+	return JsonText;
+}
+
+void ULPTLoadSessionReport::WriteToFileAsync()
+{
+	const FString FileName = FString::Printf(TEXT("%s_%s_%d.json"),
+		*Data.LevelName.ToString(),
+		*FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")),
+		Data.LoadHandleId
+	);
+	const FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("LPT"), TEXT("Sessions"), FileName);
+	FilePath = ReportPath;
+
+	// Serialization and file IO run off the game thread, the transition that just finished is not delayed by them.
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [ReportData = Data, ReportPath]()
+	{
+		FString JsonText;
+		if (!FJsonObjectConverter::UStructToJsonObjectString(ReportData, JsonText))
+		{
+			return;
+		}
+
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(ReportPath), true);
+		if (!FFileHelper::SaveStringToFile(JsonText, *ReportPath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("LPT (WriteToFileAsync): Failed to write load session report '%s'."), *ReportPath);
+		}
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
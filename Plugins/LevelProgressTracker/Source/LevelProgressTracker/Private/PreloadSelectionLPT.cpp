@@ -0,0 +1,488 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "PreloadSelectionLPT.h"
+#include "LevelPreloadDatabaseLPT.h"
+#include "AssetCollectionDataLPT.h"
+#include "SubsytemLPT.h"
+#include "TraceLPT.h"
+#include "Algo/StableSort.h"
+#include "Engine/StreamableManager.h"
+
+namespace PreloadSelectionLPT
+{
+	const FName DefaultCollectionKey(TEXT("Default"));
+	const FName LearnedCollectionKey(TEXT("Learned"));
+
+	namespace
+	{
+		// Load options reduced to the keys and tags that decide whether a collection is selected.
+		struct FCollectionFilter
+		{
+			explicit FCollectionFilter(const FLPTLoadOptions& LoadOptions)
+				: GroupTags(LoadOptions.GroupTags)
+			{
+				RequestedCollectionKeys.Reserve(LoadOptions.CollectionKeys.Num());
+				for (const FName RequestedKey : LoadOptions.CollectionKeys)
+				{
+					if (!RequestedKey.IsNone())
+					{
+						RequestedCollectionKeys.Add(RequestedKey);
+					}
+				}
+			}
+
+			bool Matches(const FName CollectionKey, const FGameplayTagContainer& CollectionTags) const
+			{
+				if (RequestedCollectionKeys.Num() > 0)
+				{
+					return RequestedCollectionKeys.Contains(CollectionKey);
+				}
+
+				if (!GroupTags.IsEmpty())
+				{
+					return CollectionTags.HasAny(GroupTags);
+				}
+
+				// Assets learned by record mode complete the default selection.
+				return CollectionKey == DefaultCollectionKey || CollectionKey == LearnedCollectionKey;
+			}
+
+			TSet<FName> RequestedCollectionKeys;
+			const FGameplayTagContainer& GroupTags;
+		};
+
+		// Merges asset lists sorted by AssetOrderLess in one pass. Returns false without output if any list is unsorted,
+		// or if cook-ordered and path-ordered lists are mixed, since their keys do not compare.
+		bool MergeSortedAssetLists(
+			const TArray<UAssetCollectionDataLPT*>& Collections,
+			const bool bHasCostWeights,
+			const bool bHasTiers,
+			TArray<FSoftObjectPath>& OutMergedPaths,
+			TArray<int64>& OutMergedCostWeights,
+			TArray<ELPTAssetPriorityTier>& OutMergedTiers)
+		{
+			int32 TotalAssetCount = 0;
+			TOptional<bool> bHasLoadOrder;
+			for (const UAssetCollectionDataLPT* CollectionAsset : Collections)
+			{
+				if (!CollectionAsset)
+				{
+					continue;
+				}
+
+				if (!bHasLoadOrder.IsSet())
+				{
+					bHasLoadOrder = CollectionAsset->HasAssetLoadOrder();
+				}
+
+				if (CollectionAsset->HasAssetLoadOrder() != bHasLoadOrder.GetValue() || !CollectionAsset->IsAssetListSorted())
+				{
+					return false;
+				}
+
+				TotalAssetCount += CollectionAsset->AssetList.Num();
+			}
+
+			OutMergedPaths.Reserve(TotalAssetCount);
+			OutMergedCostWeights.Reserve(bHasCostWeights ? TotalAssetCount : 0);
+			OutMergedTiers.Reserve(bHasTiers ? TotalAssetCount : 0);
+
+			TArray<int32> Cursors;
+			Cursors.SetNumZeroed(Collections.Num());
+
+			while (true)
+			{
+				// Strict comparison keeps the first collection on equal paths.
+				int32 MinCollectionIndex = INDEX_NONE;
+				for (int32 CollectionIndex = 0; CollectionIndex < Collections.Num(); ++CollectionIndex)
+				{
+					const UAssetCollectionDataLPT* CollectionAsset = Collections[CollectionIndex];
+					const int32 Cursor = Cursors[CollectionIndex];
+					if (!CollectionAsset || !CollectionAsset->AssetList.IsValidIndex(Cursor))
+					{
+						continue;
+					}
+
+					if (MinCollectionIndex == INDEX_NONE ||
+						UAssetCollectionDataLPT::AssetOrderLess(
+							CollectionAsset->GetAssetLoadOrderKey(Cursor), CollectionAsset->AssetList[Cursor],
+							Collections[MinCollectionIndex]->GetAssetLoadOrderKey(Cursors[MinCollectionIndex]), Collections[MinCollectionIndex]->AssetList[Cursors[MinCollectionIndex]]))
+					{
+						MinCollectionIndex = CollectionIndex;
+					}
+				}
+
+				if (MinCollectionIndex == INDEX_NONE)
+				{
+					break;
+				}
+
+				const UAssetCollectionDataLPT* MinCollection = Collections[MinCollectionIndex];
+				const int32 MinAssetIndex = Cursors[MinCollectionIndex];
+				const FSoftObjectPath& AssetPath = MinCollection->AssetList[MinAssetIndex];
+				const int32 AssetLoadOrderKey = MinCollection->GetAssetLoadOrderKey(MinAssetIndex);
+				if (AssetPath.IsValid())
+				{
+					OutMergedPaths.Add(AssetPath);
+
+					if (bHasCostWeights)
+					{
+						OutMergedCostWeights.Add(MinCollection->GetAssetCostWeight(MinAssetIndex));
+					}
+
+					if (bHasTiers)
+					{
+						OutMergedTiers.Add(MinCollection->GetAssetPriorityTier(MinAssetIndex));
+					}
+				}
+
+				// Every list is positioned at or after AssetPath, so equal entries are exactly the ones not greater than it.
+				// A package has one key per cook, so equal paths always carry equal keys.
+				for (int32 CollectionIndex = 0; CollectionIndex < Collections.Num(); ++CollectionIndex)
+				{
+					const UAssetCollectionDataLPT* CollectionAsset = Collections[CollectionIndex];
+					while (CollectionAsset && CollectionAsset->AssetList.IsValidIndex(Cursors[CollectionIndex]) &&
+						!UAssetCollectionDataLPT::AssetOrderLess(
+							AssetLoadOrderKey, AssetPath,
+							CollectionAsset->GetAssetLoadOrderKey(Cursors[CollectionIndex]), CollectionAsset->AssetList[Cursors[CollectionIndex]]))
+					{
+						++Cursors[CollectionIndex];
+					}
+				}
+			}
+
+			return true;
+		}
+
+		// True if the lists of the baked merged list line up and every collection it was merged from has a record.
+		bool IsMergedListConsistent(const FLevelPreloadEntryLPT& LevelEntry, const FLevelMergedListLPT& MergedList)
+		{
+			const int32 AssetCount = MergedList.AssetList.Num();
+			if (MergedList.CollectionKeys.Num() != MergedList.Collections.Num() ||
+				(!MergedList.AssetCostWeights.IsEmpty() && MergedList.AssetCostWeights.Num() != AssetCount) ||
+				(!MergedList.AssetTiers.IsEmpty() && MergedList.AssetTiers.Num() != AssetCount))
+			{
+				return false;
+			}
+
+			int32 TotalAssetCount = 0;
+			for (const FSoftObjectPath& CollectionPath : MergedList.Collections)
+			{
+				const FLevelCollectionRecordLPT* CollectionRecord = LevelEntry.RuntimeRecord.Collections.FindByPredicate([&CollectionPath](const FLevelCollectionRecordLPT& Record)
+				{
+					return Record.Collection.ToSoftObjectPath() == CollectionPath;
+				});
+
+				if (!CollectionRecord)
+				{
+					return false;
+				}
+
+				TotalAssetCount += CollectionRecord->AssetCount;
+			}
+
+			// Merging only removes duplicates.
+			return AssetCount <= TotalAssetCount;
+		}
+	}
+
+	void SelectCollectionPathsForLoad(
+		const FLevelPreloadEntryLPT& LevelEntry,
+		const FLPTLoadOptions& LoadOptions,
+		TArray<FSoftObjectPath>& OutCollectionPaths,
+		const bool bUseRuntimeRecord)
+	{
+		OutCollectionPaths.Reset();
+
+		if (!LevelEntry.RuntimeRecord.bBaked || !bUseRuntimeRecord)
+		{
+			for (const TSoftObjectPtr<UAssetCollectionDataLPT>& CollectionRef : LevelEntry.Collections)
+			{
+				const FSoftObjectPath CollectionPath = CollectionRef.ToSoftObjectPath();
+				if (CollectionPath.IsValid())
+				{
+					OutCollectionPaths.AddUnique(CollectionPath);
+				}
+			}
+			return;
+		}
+
+		const FCollectionFilter Filter(LoadOptions);
+		for (const FLevelCollectionRecordLPT& CollectionRecord : LevelEntry.RuntimeRecord.Collections)
+		{
+			const FSoftObjectPath CollectionPath = CollectionRecord.Collection.ToSoftObjectPath();
+			if (CollectionPath.IsValid() && Filter.Matches(CollectionRecord.CollectionKey, CollectionRecord.GroupTags))
+			{
+				OutCollectionPaths.AddUnique(CollectionPath);
+			}
+		}
+	}
+
+	void SelectCollectionsForLoad(
+		const FLevelPreloadEntryLPT& LevelEntry,
+		const FLPTLoadOptions& LoadOptions,
+		TArray<UAssetCollectionDataLPT*>& OutSelectedCollections,
+		const bool bUseRuntimeRecord)
+	{
+		LPT_TRACE_SCOPE(LPT_SelectCollectionsForLoad);
+
+		OutSelectedCollections.Reset();
+
+		// Baked records are matched without touching collection assets, only the selected ones have to be resident.
+		if (LevelEntry.RuntimeRecord.bBaked && bUseRuntimeRecord)
+		{
+			TArray<FSoftObjectPath> CollectionPaths;
+			SelectCollectionPathsForLoad(LevelEntry, LoadOptions, CollectionPaths);
+
+			for (const FSoftObjectPath& CollectionPath : CollectionPaths)
+			{
+				if (UAssetCollectionDataLPT* CollectionAsset = Cast<UAssetCollectionDataLPT>(CollectionPath.ResolveObject()))
+				{
+					OutSelectedCollections.Add(CollectionAsset);
+				}
+			}
+			return;
+		}
+
+		const FCollectionFilter Filter(LoadOptions);
+		TSet<FSoftObjectPath> UniqueCollectionPaths;
+		for (const TSoftObjectPtr<UAssetCollectionDataLPT>& CollectionRef : LevelEntry.Collections)
+		{
+			const FSoftObjectPath CollectionPath = CollectionRef.ToSoftObjectPath();
+			if (!CollectionPath.IsValid() || UniqueCollectionPaths.Contains(CollectionPath))
+			{
+				continue;
+			}
+
+			// Collections are loaded by the batched metadata request before selection runs.
+			UAssetCollectionDataLPT* CollectionAsset = CollectionRef.Get();
+			if (!CollectionAsset || !Filter.Matches(CollectionAsset->CollectionKey, CollectionAsset->GroupTags))
+			{
+				continue;
+			}
+
+			UniqueCollectionPaths.Add(CollectionPath);
+			OutSelectedCollections.Add(CollectionAsset);
+		}
+	}
+
+	bool IsRuntimeRecordCurrent(const FLevelPreloadEntryLPT& LevelEntry, const FLPTLoadOptions& LoadOptions)
+	{
+		if (!LevelEntry.RuntimeRecord.bBaked)
+		{
+			return false;
+		}
+
+		const FCollectionFilter Filter(LoadOptions);
+		for (const FLevelCollectionRecordLPT& CollectionRecord : LevelEntry.RuntimeRecord.Collections)
+		{
+			if (!Filter.Matches(CollectionRecord.CollectionKey, CollectionRecord.GroupTags))
+			{
+				continue;
+			}
+
+			const UAssetCollectionDataLPT* CollectionAsset = CollectionRecord.Collection.Get();
+			if (!CollectionAsset)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("LPT (IsRuntimeRecordCurrent): Collection '%s' is not loaded."),
+					*CollectionRecord.Collection.ToString()
+				);
+				return false;
+			}
+
+			// Key and tags decide selection, so a change to them makes the selection itself outdated.
+			if (CollectionAsset->CollectionContentHash != CollectionRecord.CollectionContentHash ||
+				CollectionAsset->AssetList.Num() != CollectionRecord.AssetCount ||
+				CollectionAsset->CollectionKey != CollectionRecord.CollectionKey ||
+				CollectionAsset->GroupTags != CollectionRecord.GroupTags)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("LPT (IsRuntimeRecordCurrent): Collection '%s' changed after the preload database was cooked."),
+					*CollectionRecord.Collection.ToString()
+				);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const FLevelMergedListLPT* FindMergedList(const FLevelPreloadEntryLPT& LevelEntry, const TArray<FSoftObjectPath>& SelectedCollectionPaths)
+	{
+		if (!LevelEntry.RuntimeRecord.bBaked || SelectedCollectionPaths.IsEmpty())
+		{
+			return nullptr;
+		}
+
+		return LevelEntry.RuntimeRecord.MergedLists.FindByPredicate([&SelectedCollectionPaths](const FLevelMergedListLPT& MergedList)
+		{
+			return MergedList.Collections == SelectedCollectionPaths;
+		});
+	}
+
+	const FLevelMergedListLPT* FindSelectedMergedList(const FLevelPreloadEntryLPT& LevelEntry, const FLPTLoadOptions& LoadOptions)
+	{
+		if (!LevelEntry.RuntimeRecord.bBaked)
+		{
+			return nullptr;
+		}
+
+		TArray<FSoftObjectPath> CollectionPaths;
+		SelectCollectionPathsForLoad(LevelEntry, LoadOptions, CollectionPaths);
+
+		const FLevelMergedListLPT* MergedList = FindMergedList(LevelEntry, CollectionPaths);
+		if (MergedList && !IsMergedListConsistent(LevelEntry, *MergedList))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("LPT (FindSelectedMergedList): Baked merged list of level '%s' does not match its collection records. Merging the collections instead."),
+				*LevelEntry.Level.ToString()
+			);
+			return nullptr;
+		}
+
+		return MergedList;
+	}
+
+	void BuildPreloadList(
+		const FLevelPreloadEntryLPT& LevelEntry,
+		const FLPTLoadOptions& LoadOptions,
+		FPreloadListLPT& OutPreloadList,
+		const bool bUseRuntimeRecord)
+	{
+		OutPreloadList = FPreloadListLPT();
+
+		if (LevelEntry.RuntimeRecord.bBaked && bUseRuntimeRecord)
+		{
+			if (const FLevelMergedListLPT* MergedList = FindSelectedMergedList(LevelEntry, LoadOptions))
+			{
+				OutPreloadList.Paths = MergedList->AssetList;
+				OutPreloadList.CostWeights = MergedList->AssetCostWeights;
+				OutPreloadList.Tiers = MergedList->AssetTiers;
+				OutPreloadList.SelectedCollections = MergedList->Collections;
+				OutPreloadList.SelectedCollectionKeys = MergedList->CollectionKeys;
+				OutPreloadList.bPinResident = MergedList->bPinResident;
+				OutPreloadList.bInLoadOrder = MergedList->bInLoadOrder;
+				return;
+			}
+		}
+
+		TArray<UAssetCollectionDataLPT*> SelectedCollections;
+		SelectCollectionsForLoad(LevelEntry, LoadOptions, SelectedCollections, bUseRuntimeRecord);
+		MergeCollectionAssetLists(SelectedCollections, OutPreloadList.Paths, OutPreloadList.CostWeights, OutPreloadList.Tiers);
+
+		OutPreloadList.bInLoadOrder = !SelectedCollections.IsEmpty();
+		for (const UAssetCollectionDataLPT* CollectionAsset : SelectedCollections)
+		{
+			OutPreloadList.SelectedCollections.Add(FSoftObjectPath(CollectionAsset));
+			OutPreloadList.SelectedCollectionKeys.Add(CollectionAsset->CollectionKey);
+			OutPreloadList.bPinResident |= CollectionAsset->bPinResident;
+			OutPreloadList.bInLoadOrder &= CollectionAsset->HasAssetLoadOrder();
+		}
+	}
+
+	void MergeCollectionAssetLists(
+		const TArray<UAssetCollectionDataLPT*>& Collections,
+		TArray<FSoftObjectPath>& OutMergedPaths,
+		TArray<int64>& OutMergedCostWeights,
+		TArray<ELPTAssetPriorityTier>& OutMergedTiers)
+	{
+		LPT_TRACE_SCOPE(LPT_MergeCollectionAssetLists);
+
+		OutMergedPaths.Reset();
+		OutMergedCostWeights.Reset();
+		OutMergedTiers.Reset();
+
+		// Weights are used only if at least one collection was generated with them.
+		const bool bHasCostWeights = Collections.ContainsByPredicate([](const UAssetCollectionDataLPT* CollectionAsset)
+		{
+			return CollectionAsset && !CollectionAsset->AssetCostWeights.IsEmpty();
+		});
+		const bool bHasTiers = Collections.ContainsByPredicate([](const UAssetCollectionDataLPT* CollectionAsset)
+		{
+			return CollectionAsset && !CollectionAsset->AssetTiers.IsEmpty();
+		});
+
+		// Collections saved before lists were kept sorted fall back to the hash set merge.
+		if (!MergeSortedAssetLists(Collections, bHasCostWeights, bHasTiers, OutMergedPaths, OutMergedCostWeights, OutMergedTiers))
+		{
+			TSet<FSoftObjectPath> UniquePaths;
+			for (const UAssetCollectionDataLPT* CollectionAsset : Collections)
+			{
+				if (!CollectionAsset)
+				{
+					continue;
+				}
+
+				for (int32 AssetIndex = 0; AssetIndex < CollectionAsset->AssetList.Num(); ++AssetIndex)
+				{
+					const FSoftObjectPath& AssetPath = CollectionAsset->AssetList[AssetIndex];
+					if (!AssetPath.IsValid() || UniquePaths.Contains(AssetPath))
+					{
+						continue;
+					}
+
+					UniquePaths.Add(AssetPath);
+					OutMergedPaths.Add(AssetPath);
+
+					if (bHasCostWeights)
+					{
+						OutMergedCostWeights.Add(CollectionAsset->GetAssetCostWeight(AssetIndex));
+					}
+
+					if (bHasTiers)
+					{
+						OutMergedTiers.Add(CollectionAsset->GetAssetPriorityTier(AssetIndex));
+					}
+				}
+			}
+		}
+
+		if (!bHasTiers)
+		{
+			return;
+		}
+
+		TArray<int32> SortedIndices;
+		SortedIndices.Reserve(OutMergedPaths.Num());
+		for (int32 PathIndex = 0; PathIndex < OutMergedPaths.Num(); ++PathIndex)
+		{
+			SortedIndices.Add(PathIndex);
+		}
+
+		Algo::StableSortBy(SortedIndices, [&OutMergedTiers](const int32 PathIndex)
+		{
+			return static_cast<uint8>(OutMergedTiers[PathIndex]);
+		});
+
+		TArray<FSoftObjectPath> SortedPaths;
+		TArray<int64> SortedCostWeights;
+		TArray<ELPTAssetPriorityTier> SortedTiers;
+		SortedPaths.Reserve(SortedIndices.Num());
+		SortedCostWeights.Reserve(bHasCostWeights ? SortedIndices.Num() : 0);
+		SortedTiers.Reserve(SortedIndices.Num());
+		for (const int32 PathIndex : SortedIndices)
+		{
+			SortedPaths.Add(OutMergedPaths[PathIndex]);
+			SortedTiers.Add(OutMergedTiers[PathIndex]);
+			if (bHasCostWeights)
+			{
+				SortedCostWeights.Add(OutMergedCostWeights[PathIndex]);
+			}
+		}
+
+		OutMergedPaths = MoveTemp(SortedPaths);
+		OutMergedCostWeights = MoveTemp(SortedCostWeights);
+		OutMergedTiers = MoveTemp(SortedTiers);
+	}
+
+	int32 GetTierAsyncLoadPriority(const ELPTAssetPriorityTier Tier)
+	{
+		switch (Tier)
+		{
+		case ELPTAssetPriorityTier::Critical:
+			return FStreamableManager::AsyncLoadHighPriority + 50;
+		case ELPTAssetPriorityTier::Deferred:
+			return FStreamableManager::DefaultAsyncLoadPriority;
+		default:
+			return FStreamableManager::AsyncLoadHighPriority;
+		}
+	}
+}
@@ -0,0 +1,87 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SettingsLPT.h"
+#include "UObject/SoftObjectPath.h"
+
+class UAssetCollectionDataLPT;
+struct FLevelMergedListLPT;
+struct FLevelPreloadEntryLPT;
+struct FLPTLoadOptions;
+
+// Runtime collection selection shared by level preload and speculative prefetch.
+namespace PreloadSelectionLPT
+{
+	extern const FName DefaultCollectionKey;
+	extern const FName LearnedCollectionKey;
+
+	// Raises preload requests of a foreground OpenLevel above background level instance loads of the same tier.
+	constexpr int32 ForegroundPreloadPriorityBoost = 10;
+
+	// Merged preload list of a selection together with what was selected.
+	struct FPreloadListLPT
+	{
+		TArray<FSoftObjectPath> Paths;
+		TArray<int64> CostWeights;
+		TArray<ELPTAssetPriorityTier> Tiers;
+		TArray<FSoftObjectPath> SelectedCollections;
+		TArray<FName> SelectedCollectionKeys;
+		bool bPinResident = false;
+
+		// True when every selected collection carries cook load order keys, so Paths follow the container order.
+		bool bInLoadOrder = false;
+	};
+
+	// Paths of the collections that SelectCollectionsForLoad can pick. With a baked runtime record only the matching
+	// collections are returned. Unbaked entries, or a record rejected by IsRuntimeRecordCurrent, return every collection
+	// because selection needs the loaded assets.
+	void SelectCollectionPathsForLoad(
+		const FLevelPreloadEntryLPT& LevelEntry,
+		const FLPTLoadOptions& LoadOptions,
+		TArray<FSoftObjectPath>& OutCollectionPaths,
+		bool bUseRuntimeRecord = true);
+
+	// Selects loaded collection assets of the entry by collection keys, group tags or the "Default" and "Learned" keys.
+	void SelectCollectionsForLoad(
+		const FLevelPreloadEntryLPT& LevelEntry,
+		const FLPTLoadOptions& LoadOptions,
+		TArray<UAssetCollectionDataLPT*>& OutSelectedCollections,
+		bool bUseRuntimeRecord = true);
+
+	// True if every collection the baked record selects is resident and still matches its record. Used when the
+	// selection has no merged list and its collections are loaded anyway. A collection edited without a database cook
+	// changes its content hash and rejects the record.
+	bool IsRuntimeRecordCurrent(const FLevelPreloadEntryLPT& LevelEntry, const FLPTLoadOptions& LoadOptions);
+
+	// Finds the baked merged list of exactly these selected collections. Returns nullptr when none was precomputed.
+	const FLevelMergedListLPT* FindMergedList(const FLevelPreloadEntryLPT& LevelEntry, const TArray<FSoftObjectPath>& SelectedCollectionPaths);
+
+	// Finds the baked merged list of the collections the load options select, if it is consistent with the collection
+	// records of the entry. Collection assets are not needed: the database cook depends on the collection packages,
+	// so a baked list always matches the cooked collections. Returns nullptr when the selection has to be merged.
+	const FLevelMergedListLPT* FindSelectedMergedList(const FLevelPreloadEntryLPT& LevelEntry, const FLPTLoadOptions& LoadOptions);
+
+	// Copies the baked merged list of the selection, or merges the resident selected collections when none matches.
+	// An inconsistent merged list is logged and merged again.
+	void BuildPreloadList(
+		const FLevelPreloadEntryLPT& LevelEntry,
+		const FLPTLoadOptions& LoadOptions,
+		FPreloadListLPT& OutPreloadList,
+		bool bUseRuntimeRecord = true);
+
+	// Merges asset lists of the collections without duplicates. Cost weights and tiers are filled only if any collection has them.
+	// Lists sorted by UAssetCollectionDataLPT::AssetOrderLess are merged in one pass, so cook-ordered lists stay in
+	// container order. Unsorted or mixed lists go through a hash set.
+	// A path found in several collections takes weight and tier of the first one. With tiers the merged list is
+	// stable-sorted critical first, keeping the merge order inside each tier.
+	void MergeCollectionAssetLists(
+		const TArray<UAssetCollectionDataLPT*>& Collections,
+		TArray<FSoftObjectPath>& OutMergedPaths,
+		TArray<int64>& OutMergedCostWeights,
+		TArray<ELPTAssetPriorityTier>& OutMergedTiers);
+
+	// Async load priority used for requests of the tier. Normal keeps the regular high preload priority.
+	int32 GetTierAsyncLoadPriority(ELPTAssetPriorityTier Tier);
+}
@@ -0,0 +1,38 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "ResidentBudgetLPT.h"
+#include "SubsytemLPT.h"
+
+namespace ResidentBudgetLPT
+{
+	bool HoldsResidentAssets(const FLevelState& LevelState)
+	{
+		// Deferred preloads have requested nothing yet.
+		return !LevelState.bCancelled && !LevelState.bBudgetDeferred && LevelState.ResidentCostWeight > 0;
+	}
+
+	bool IsPreloadRunning(const FLevelState& LevelState)
+	{
+		const bool bLevelInstanceLoaded = LevelState.LoadMethod == ELevelLoadMethod::LevelStreaming && LevelState.LevelInstanceState.IsLoaded;
+		return HoldsResidentAssets(LevelState) && !bLevelInstanceLoaded;
+	}
+
+	FBudgetDecisionLPT DecideIncomingPreload(int64 HeldCostWeight, int64 PrefetchCostWeight, bool bHasRunningPreload, bool bIncomingPinned, int64 IncomingCostWeight, int64 BudgetBytes)
+	{
+		FBudgetDecisionLPT Decision;
+		if (HeldCostWeight + PrefetchCostWeight + IncomingCostWeight <= BudgetBytes)
+		{
+			return Decision;
+		}
+
+		Decision.bReleasePrefetch = PrefetchCostWeight > 0;
+		if (HeldCostWeight + IncomingCostWeight <= BudgetBytes)
+		{
+			return Decision;
+		}
+
+		Decision.bDeferIncoming = bHasRunningPreload && !bIncomingPinned;
+		Decision.bExceedsBudget = !Decision.bDeferIncoming;
+		return Decision;
+	}
+}
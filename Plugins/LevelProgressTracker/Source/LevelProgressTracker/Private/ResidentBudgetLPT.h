@@ -0,0 +1,36 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FLevelState;
+
+// Resident memory budget decisions, kept free of subsystem state so they can be tested in isolation.
+namespace ResidentBudgetLPT
+{
+	// What to do with an incoming preload.
+	struct FBudgetDecisionLPT
+	{
+		// Release the speculative prefetch before the preload starts.
+		bool bReleasePrefetch = false;
+
+		// Hold the preload back until a running preload has finished.
+		bool bDeferIncoming = false;
+
+		// The preload starts although it does not fit, nothing else can be released or waited for.
+		bool bExceedsBudget = false;
+	};
+
+	// True if the level state is counted against the budget. Loaded level instances are counted until they are unloaded,
+	// their actors keep the preloaded assets referenced after the handles were released.
+	bool HoldsResidentAssets(const FLevelState& LevelState);
+
+	// True if the level state is preloading or opening its level. Its overfetched assets are released once the level
+	// is opened or shown, so an incoming preload may wait for it.
+	bool IsPreloadRunning(const FLevelState& LevelState);
+
+	// Decides how the incoming preload fits the budget. Live level states are never released, only the speculative
+	// prefetch is. Pinned preloads are never deferred.
+	FBudgetDecisionLPT DecideIncomingPreload(int64 HeldCostWeight, int64 PrefetchCostWeight, bool bHasRunningPreload, bool bIncomingPinned, int64 IncomingCostWeight, int64 BudgetBytes);
+}
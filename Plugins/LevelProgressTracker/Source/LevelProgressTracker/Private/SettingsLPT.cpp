@@ -156,7 +156,13 @@ void ULevelProgressTrackerSettings::BuildGlobalDefaultRules(FLPTFilterSettings&
 	OutRules = FLPTFilterSettings();
 	OutRules.bUseChunkedPreload = bUseChunkedPreload;
 	OutRules.PreloadChunkSize = FMath::Max(1, PreloadChunkSize);
+	OutRules.bUseAdaptiveChunkSize = bUseAdaptiveChunkSize;
+	OutRules.MinAdaptiveChunkSize = FMath::Max(1, MinAdaptiveChunkSize);
+	OutRules.MaxAdaptiveChunkSize = FMath::Max(OutRules.MinAdaptiveChunkSize, MaxAdaptiveChunkSize);
+	OutRules.TargetChunkLoadTime = FMath::Max(0.01f, TargetChunkLoadTime);
+	OutRules.MaxChunksInFlight = FMath::Max(1, MaxChunksInFlight);
 	OutRules.AssetClassFilter = AssetClassFilter;
+	OutRules.AssetTierRules = AssetTierRules;
 }
 
 void ULevelProgressTrackerSettings::OpenLevelRulesEditorForCurrentLevel()
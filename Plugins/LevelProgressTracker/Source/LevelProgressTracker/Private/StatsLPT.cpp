@@ -0,0 +1,46 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "StatsLPT.h"
+
+DEFINE_STAT(STAT_LPT_ActiveLevelStates);
+DEFINE_STAT(STAT_LPT_OutstandingChunks);
+DEFINE_STAT(STAT_LPT_HeldPreloadAssets);
+DEFINE_STAT(STAT_LPT_AssetsRequested);
+DEFINE_STAT(STAT_LPT_AssetsLoaded);
+DEFINE_STAT(STAT_LPT_RequestToOpenTime);
+DEFINE_STAT(STAT_LPT_Callbacks);
+
+CSV_DEFINE_CATEGORY(LPT, true);
+
+namespace StatsLPT
+{
+	void AddAssetsRequested(int32 AssetCount)
+	{
+		INC_DWORD_STAT_BY(STAT_LPT_AssetsRequested, AssetCount);
+		CSV_CUSTOM_STAT(LPT, AssetsRequested, AssetCount, ECsvCustomStatOp::Accumulate);
+	}
+
+	void AddAssetsLoaded(int32 AssetCount)
+	{
+		INC_DWORD_STAT_BY(STAT_LPT_AssetsLoaded, AssetCount);
+		CSV_CUSTOM_STAT(LPT, AssetsLoaded, AssetCount, ECsvCustomStatOp::Accumulate);
+	}
+
+	void SetRequestToOpenTime(double Seconds)
+	{
+		const float Milliseconds = static_cast<float>(Seconds * 1000.0);
+		SET_FLOAT_STAT(STAT_LPT_RequestToOpenTime, Milliseconds);
+		CSV_CUSTOM_STAT(LPT, RequestToOpenMs, Milliseconds, ECsvCustomStatOp::Set);
+	}
+
+	void SetFrameGauges(int32 ActiveLevelStates, int32 OutstandingChunks, int32 HeldPreloadAssets)
+	{
+		SET_DWORD_STAT(STAT_LPT_ActiveLevelStates, ActiveLevelStates);
+		SET_DWORD_STAT(STAT_LPT_OutstandingChunks, OutstandingChunks);
+		SET_DWORD_STAT(STAT_LPT_HeldPreloadAssets, HeldPreloadAssets);
+
+		CSV_CUSTOM_STAT(LPT, ActiveLevelStates, ActiveLevelStates, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(LPT, OutstandingChunks, OutstandingChunks, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(LPT, HeldPreloadAssets, HeldPreloadAssets, ECsvCustomStatOp::Set);
+	}
+}
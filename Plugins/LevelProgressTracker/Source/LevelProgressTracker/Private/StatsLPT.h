@@ -0,0 +1,38 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+// LPT runtime counters, viewable with "stat LPT" and recorded to the "LPT" category of -csvprofile captures.
+DECLARE_STATS_GROUP(TEXT("LPT"), STATGROUP_LPT, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Level States"), STAT_LPT_ActiveLevelStates, STATGROUP_LPT, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Outstanding Chunks"), STAT_LPT_OutstandingChunks, STATGROUP_LPT, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Held Preload Assets"), STAT_LPT_HeldPreloadAssets, STATGROUP_LPT, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Assets Requested"), STAT_LPT_AssetsRequested, STATGROUP_LPT, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Assets Loaded"), STAT_LPT_AssetsLoaded, STATGROUP_LPT, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Request To Open (ms)"), STAT_LPT_RequestToOpenTime, STATGROUP_LPT, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("LPT Callbacks"), STAT_LPT_Callbacks, STATGROUP_LPT, );
+
+CSV_DECLARE_CATEGORY_EXTERN(LPT);
+
+// Measures time spent in an LPT callback for both stat systems.
+#define LPT_SCOPE_CALLBACK_STATS() \
+	SCOPE_CYCLE_COUNTER(STAT_LPT_Callbacks); \
+	CSV_SCOPED_TIMING_STAT(LPT, Callbacks)
+
+namespace StatsLPT
+{
+	// Per-frame counters.
+	void AddAssetsRequested(int32 AssetCount);
+	void AddAssetsLoaded(int32 AssetCount);
+
+	// Time from the load request to the level open or level instance load request.
+	void SetRequestToOpenTime(double Seconds);
+
+	// Gauges sampled once per frame by the subsystem tick.
+	void SetFrameGauges(int32 ActiveLevelStates, int32 OutstandingChunks, int32 HeldPreloadAssets);
+}
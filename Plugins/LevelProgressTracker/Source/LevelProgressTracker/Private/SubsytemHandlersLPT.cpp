@@ -1,31 +1,136 @@
 // Pavel Gornostaev <https://github.com/Pavreally>
 
 #include "SubsytemLPT.h"
+#include "StatsLPT.h"
+#include "TraceLPT.h"
+#include "SettingsLPT.h"
 #include "Engine/Level.h"
 #include "Engine/StreamableManager.h"
+#include "HAL/PlatformTime.h"
 
 void ULevelProgressTrackerSubsytem::HandleAssetLoaded(TSharedRef<FStreamableHandle> Handle, FName PackagePath, TSharedRef<FLevelState> LevelState)
 {
+	LPT_TRACE_SCOPE(LPT_HandleAssetLoaded);
+	LPT_SCOPE_CALLBACK_STATS();
+
+	(void)Handle;
 	(void)PackagePath;
 
-	const float Progress = FMath::Clamp(Handle->GetProgress(), 0.f, 1.f);
+	// Tiered aggregated preloads report from their tier handles. The level state holds the combined handle, whose
+	// progress covers every tier.
+	const TSharedPtr<FStreamableHandle>& ProgressHandle = LevelState->Handle;
+	if (!ProgressHandle.IsValid())
+	{
+		return;
+	}
+
+	const float CountProgress = FMath::Clamp(ProgressHandle->GetProgress(), 0.f, 1.f);
+	const int32 PreviousLoadedAssets = LevelState->LoadedAssets;
 	LevelState->LoadedAssets = LevelState->TotalAssets > 0
-		? FMath::Clamp(FMath::RoundToInt(Progress * LevelState->TotalAssets), 0, LevelState->TotalAssets)
+		? FMath::Clamp(FMath::RoundToInt(CountProgress * LevelState->TotalAssets), 0, LevelState->TotalAssets)
 		: 0;
+	StatsLPT::AddAssetsLoaded(FMath::Max(0, LevelState->LoadedAssets - PreviousLoadedAssets));
+
+	// Update delegates fire per asset, the resident scan runs at most once per frame.
+	if (LevelState->TotalCostWeight > 0 && LevelState->LastCostScanFrame != GFrameCounter)
+	{
+		LevelState->LastCostScanFrame = GFrameCounter;
+
+		TArray<int32>& PendingCostIndices = LevelState->PendingCostIndices;
+		for (int32 PendingIndex = PendingCostIndices.Num() - 1; PendingIndex >= 0; --PendingIndex)
+		{
+			const int32 PathIndex = PendingCostIndices[PendingIndex];
+			if (LevelState->PreloadPaths[PathIndex].ResolveObject())
+			{
+				LevelState->LoadedCostWeight += LevelState->PreloadCostWeights[PathIndex];
+				PendingCostIndices.RemoveAtSwap(PendingIndex, 1, EAllowShrinking::No);
+			}
+		}
+	}
+
+	const float Progress = LevelState->TotalCostWeight > 0 ? LevelState->GetPreloadProgress() : CountProgress;
+	BroadcastLevelLoadProgress(LevelState, Progress);
+}
+
+void ULevelProgressTrackerSubsytem::BroadcastLevelLoadProgress(TSharedRef<FLevelState> LevelState, float Progress, bool bForce)
+{
+	if (Progress > LevelState->Progress)
+	{
+		LevelState->LastProgressTime = FPlatformTime::Seconds();
+		LevelState->bStallReported = false;
+	}
+
+	LevelState->Progress = Progress;
+
+	if (!bForce)
+	{
+		// At most one broadcast per frame, and only once progress moved by the configured delta.
+		const float MinProgressDelta = GetDefault<ULevelProgressTrackerSettings>()->MinProgressBroadcastDelta;
+		if (LevelState->LastBroadcastFrame == GFrameCounter || Progress - LevelState->BroadcastProgress < MinProgressDelta)
+		{
+			LevelState->bProgressBroadcastPending = true;
+			return;
+		}
+	}
+
+	LevelState->bProgressBroadcastPending = false;
+	LevelState->LastBroadcastFrame = GFrameCounter;
+	LevelState->BroadcastProgress = Progress;
+
+	if (OnLevelLoadProgressNativeLPT.IsBound())
+	{
+		FLPTLoadProgress LoadProgress;
+		LoadProgress.Progress = Progress;
+		LoadProgress.LoadedAssets = LevelState->LoadedAssets;
+		LoadProgress.TotalAssets = LevelState->TotalAssets;
+		OnLevelLoadProgressNativeLPT.Broadcast(LevelState->LoadHandle, LoadProgress);
+	}
 
 	OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, Progress, LevelState->LoadedAssets, LevelState->TotalAssets);
 }
 
+void ULevelProgressTrackerSubsytem::FlushPendingProgressBroadcasts()
+{
+	TArray<TSharedRef<FLevelState>> PendingStates;
+	for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+	{
+		if (Level.Value.IsValid() && Level.Value->bProgressBroadcastPending && !Level.Value->bCancelled)
+		{
+			PendingStates.Add(Level.Value.ToSharedRef());
+		}
+	}
+
+	// Listeners may start or cancel loads, so broadcast outside the map iteration.
+	for (const TSharedRef<FLevelState>& LevelState : PendingStates)
+	{
+		BroadcastLevelLoadProgress(LevelState, LevelState->Progress);
+	}
+}
+
 void ULevelProgressTrackerSubsytem::OnAllAssetsLoaded(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState)
 {
+	LPT_TRACE_SCOPE(LPT_OnAllAssetsLoaded);
+	LPT_SCOPE_CALLBACK_STATS();
+
+	if (LevelState->bCancelled)
+	{
+		return;
+	}
+
+	CollectFailedPreloadPaths(LevelState);
+
 	LevelState->PreloadPaths.Reset();
+	LevelState->PreloadCostWeights.Reset();
+	LevelState->PreloadTiers.Reset();
+	LevelState->PendingCostIndices.Reset();
 	LevelState->NextPreloadPathIndex = 0;
 
 	// Ensure LoadedAssets equals TotalAssets for accurate 100% reporting
 	LevelState->LoadedAssets = LevelState->TotalAssets;
+	LevelState->LoadedCostWeight = LevelState->TotalCostWeight;
 
 	// Broadcast final progress and loaded events
-	OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, 1.f, LevelState->LoadedAssets, LevelState->TotalAssets);
+	BroadcastLevelLoadProgress(LevelState, 1.f, true);
 
 	StartLevelLPT(PackagePath, bIsStreamingLevel, LevelState);
 }
@@ -58,6 +163,9 @@ void ULevelProgressTrackerSubsytem::ReleaseLevelStateHandles(TSharedRef<FLevelSt
 	};
 
 	ReleaseOneHandle(LevelState->Handle);
+	ReleaseOneHandle(LevelState->MetadataHandle);
+	ReleaseOneHandle(LevelState->RetargetHandle);
+	LevelState->RetargetPaths.Reset();
 
 	for (TSharedPtr<FStreamableHandle>& ChunkHandle : LevelState->ChunkHandles)
 	{
@@ -65,40 +173,179 @@ void ULevelProgressTrackerSubsytem::ReleaseLevelStateHandles(TSharedRef<FLevelSt
 	}
 
 	LevelState->ChunkHandles.Reset();
+	LevelState->InFlightChunks.Reset();
+
+	// Requests of a package preload cannot be cancelled. Their late callbacks no longer match and are ignored.
+	LevelState->PackagePreload.Reset();
+	LevelState->ResidentCostWeight = 0;
 }
 
-void ULevelProgressTrackerSubsytem::OnPreloadChunkLoaded(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, int32 LoadedChunkAssetCount)
+void ULevelProgressTrackerSubsytem::ReleaseMetadataHandle(TSharedRef<FLevelState> LevelState)
 {
-	(void)LoadedChunkAssetCount;
+	if (LevelState->MetadataHandle.IsValid())
+	{
+		LevelState->MetadataHandle->ReleaseHandle();
+		LevelState->MetadataHandle.Reset();
+	}
+}
 
-	LevelState->LoadedAssets = FMath::Clamp(LevelState->NextPreloadPathIndex, 0, LevelState->TotalAssets);
+void ULevelProgressTrackerSubsytem::OnPreloadChunkLoaded(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, int32 ChunkStartIndex)
+{
+	LPT_TRACE_SCOPE(LPT_OnPreloadChunkLoaded);
+	LPT_SCOPE_CALLBACK_STATS();
 
-	const float Progress = LevelState->TotalAssets > 0
-		? static_cast<float>(LevelState->LoadedAssets) / LevelState->TotalAssets
-		: 1.f;
+	if (LevelState->bCancelled)
+	{
+		return;
+	}
 
-	OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, Progress, LevelState->LoadedAssets, LevelState->TotalAssets);
+	if (const FLevelPreloadChunkLPT* Chunk = LevelState->InFlightChunks.FindByPredicate([ChunkStartIndex](const FLevelPreloadChunkLPT& InFlightChunk)
+	{
+		return InFlightChunk.StartIndex == ChunkStartIndex;
+	}))
+	{
+		const double ChunkDuration = FPlatformTime::Seconds() - Chunk->RequestTime;
+		TraceLPT::ChunkCompleted(LevelState->LoadHandle.Id, ChunkStartIndex, Chunk->AssetCount, ChunkDuration);
+		StatsLPT::AddAssetsLoaded(Chunk->AssetCount);
+
+		FLPTChunkReport& ChunkReport = LevelState->SessionReport.Chunks.AddDefaulted_GetRef();
+		ChunkReport.StartIndex = ChunkStartIndex;
+		ChunkReport.AssetCount = Chunk->AssetCount;
+		ChunkReport.Duration = static_cast<float>(ChunkDuration);
+	}
+
+	if (MarkPreloadChunkCompleted(LevelState, ChunkStartIndex))
+	{
+		BroadcastLevelLoadProgress(LevelState, LevelState->GetPreloadProgress());
+	}
 
 	StartNextPreloadChunk(PackagePath, bIsStreamingLevel, LevelState);
 }
 
-void ULevelProgressTrackerSubsytem::HandleChunkAssetLoaded(TSharedRef<FStreamableHandle> Handle, FName PackagePath, TSharedRef<FLevelState> LevelState, int32 ChunkBaseLoaded, int32 ChunkAssetCount)
+bool ULevelProgressTrackerSubsytem::MarkPreloadChunkCompleted(TSharedRef<FLevelState> LevelState, int32 ChunkStartIndex, bool bLoaded)
 {
+	TArray<FLevelPreloadChunkLPT>& InFlightChunks = LevelState->InFlightChunks;
+
+	FLevelPreloadChunkLPT* Chunk = InFlightChunks.FindByPredicate([ChunkStartIndex](const FLevelPreloadChunkLPT& InFlightChunk)
+	{
+		return InFlightChunk.StartIndex == ChunkStartIndex;
+	});
+
+	if (!Chunk || Chunk->bCompleted)
+	{
+		return false;
+	}
+
+	// With overlapping chunks, a chunk only starts occupying the loader once the previous one has finished.
+	const double CompletionTime = FPlatformTime::Seconds();
+	const double ChunkLoadTime = CompletionTime - FMath::Max(Chunk->RequestTime, LevelState->LastChunkCompletionTime);
+	LevelState->LastChunkCompletionTime = CompletionTime;
+
+	Chunk->bCompleted = true;
+
+	// Assets added by the package extension are left out of the measured time, so they do not shrink the next chunks.
+	// A failed request finishes without loading anything, its time says nothing about the loader.
+	if (bLoaded)
+	{
+		const double ScheduledLoadTime = ChunkLoadTime * Chunk->ScheduledAssetCount / FMath::Max(1, Chunk->AssetCount);
+		UpdateAdaptiveChunkSize(LevelState, Chunk->ScheduledAssetCount, ScheduledLoadTime, Chunk->RequestTime);
+	}
+
+	// Slide the window past every leading chunk that has completed.
+	int32 CompletedChunkCount = 0;
+	while (CompletedChunkCount < InFlightChunks.Num() && InFlightChunks[CompletedChunkCount].bCompleted)
+	{
+		const FLevelPreloadChunkLPT& CompletedChunk = InFlightChunks[CompletedChunkCount];
+		LevelState->CompletedPreloadPathIndex = CompletedChunk.StartIndex + CompletedChunk.AssetCount;
+		LevelState->CompletedCostWeight += CompletedChunk.CostWeight;
+		++CompletedChunkCount;
+	}
+
+	if (CompletedChunkCount == 0)
+	{
+		return false;
+	}
+
+	InFlightChunks.RemoveAt(0, CompletedChunkCount, EAllowShrinking::No);
+	LevelState->LoadedAssets = FMath::Clamp(LevelState->CompletedPreloadPathIndex, 0, LevelState->TotalAssets);
+	LevelState->LoadedCostWeight = FMath::Max(LevelState->LoadedCostWeight, LevelState->CompletedCostWeight);
+
+	return true;
+}
+
+void ULevelProgressTrackerSubsytem::UpdateAdaptiveChunkSize(TSharedRef<FLevelState> LevelState, int32 LoadedChunkAssetCount, double ChunkLoadTime, double ChunkRequestTime)
+{
+	if (!LevelState->bUseAdaptiveChunkSize)
+	{
+		return;
+	}
+
+	// Chunks in flight during a decrease complete slowly for the same reason. One decrease per window is enough.
+	if (ChunkRequestTime < LevelState->LastChunkDecreaseTime)
+	{
+		return;
+	}
+
+	// A short tail chunk says nothing about the capacity of a full one.
+	if (LoadedChunkAssetCount < LevelState->PreloadChunkSize)
+	{
+		return;
+	}
+
+	// AIMD: grow by a fixed step while under the target interval, halve when over it.
+	const int32 AdditiveIncrease = FMath::Max(1, LevelState->MinAdaptiveChunkSize);
+	const float MultiplicativeDecrease = 0.5f;
+
+	int32 NewChunkSize = LevelState->PreloadChunkSize;
+	if (ChunkLoadTime < LevelState->TargetChunkLoadTime)
+	{
+		NewChunkSize += AdditiveIncrease;
+	}
+	else if (ChunkLoadTime > LevelState->TargetChunkLoadTime)
+	{
+		NewChunkSize = FMath::FloorToInt(NewChunkSize * MultiplicativeDecrease);
+		LevelState->LastChunkDecreaseTime = FPlatformTime::Seconds();
+	}
+
+	LevelState->PreloadChunkSize = FMath::Clamp(NewChunkSize, LevelState->MinAdaptiveChunkSize, LevelState->MaxAdaptiveChunkSize);
+}
+
+void ULevelProgressTrackerSubsytem::HandleChunkAssetLoaded(TSharedRef<FStreamableHandle> Handle, FName PackagePath, TSharedRef<FLevelState> LevelState, int32 ChunkStartIndex, int32 ChunkAssetCount)
+{
+	LPT_TRACE_SCOPE(LPT_HandleChunkAssetLoaded);
+	LPT_SCOPE_CALLBACK_STATS();
+
 	(void)PackagePath;
 
+	// Later chunks may progress first; report only the head of the window to keep progress in order.
+	if (LevelState->InFlightChunks.IsEmpty() || LevelState->InFlightChunks[0].StartIndex != ChunkStartIndex)
+	{
+		return;
+	}
+
 	const float ChunkProgress = FMath::Clamp(Handle->GetProgress(), 0.f, 1.f);
 	const int32 LoadedInChunk = FMath::Clamp(FMath::RoundToInt(ChunkProgress * ChunkAssetCount), 0, ChunkAssetCount);
-	LevelState->LoadedAssets = FMath::Clamp(ChunkBaseLoaded + LoadedInChunk, 0, LevelState->TotalAssets);
+	const int32 LoadedAssets = FMath::Clamp(LevelState->CompletedPreloadPathIndex + LoadedInChunk, 0, LevelState->TotalAssets);
+	if (LoadedAssets <= LevelState->LoadedAssets)
+	{
+		return;
+	}
 
-	const float TotalProgress = LevelState->TotalAssets > 0
-		? static_cast<float>(LevelState->LoadedAssets) / LevelState->TotalAssets
-		: 0.f;
+	LevelState->LoadedAssets = LoadedAssets;
 
-	OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, TotalProgress, LevelState->LoadedAssets, LevelState->TotalAssets);
+	// Partial weight of the head chunk is interpolated by its count progress.
+	const int64 ChunkCostWeight = LevelState->InFlightChunks[0].CostWeight;
+	const int64 LoadedCostWeight = LevelState->CompletedCostWeight + static_cast<int64>(ChunkCostWeight * static_cast<double>(ChunkProgress));
+	LevelState->LoadedCostWeight = FMath::Clamp(LoadedCostWeight, LevelState->LoadedCostWeight, LevelState->TotalCostWeight);
+
+	BroadcastLevelLoadProgress(LevelState, LevelState->GetPreloadProgress());
 }
 
 void ULevelProgressTrackerSubsytem::OnLevelShown()
 {
+	LPT_TRACE_SCOPE(LPT_OnLevelShown);
+	LPT_SCOPE_CALLBACK_STATS();
+
 	// Collecting a list of packages ready for removal
 	TArray<FName> PackagesToRemove;
 	PackagesToRemove.Reserve(LevelLoadedMap.Num());
@@ -135,13 +382,20 @@ void ULevelProgressTrackerSubsytem::OnLevelShown()
 				&ULevelProgressTrackerSubsytem::OnLevelShown
 			);
 
-		// Release preload handles
+		// The loaded level references what it uses, overfetched assets are released with the handles. Its cost weight
+		// stays counted by the resident memory budget until the instance is unloaded.
+		const int64 ResidentCostWeight = LevelState->ResidentCostWeight;
 		ReleaseLevelStateHandles(LevelState.ToSharedRef(), false);
+		LevelState->ResidentCostWeight = ResidentCostWeight;
 
 		// Mark as loaded
 		LevelState->LevelInstanceState.IsLoaded = true;
 
+		FinishLoadSessionReport(LevelState.ToSharedRef());
+
 		// Notification
+		TraceLPT::LevelLoaded(LevelState->LoadHandle.Id, LevelState->LevelName);
+		OnLevelLoadedNativeLPT.Broadcast(LevelState->LoadHandle);
 		OnLevelLoadedLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName);
 	}
 }
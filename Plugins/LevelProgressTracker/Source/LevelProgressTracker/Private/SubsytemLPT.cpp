@@ -1,6 +1,8 @@
 // Pavel Gornostaev <https://github.com/Pavreally>
 
 #include "SubsytemLPT.h"
+#include "StatsLPT.h"
+#include "TraceLPT.h"
 #include "LevelPreloadAssetFilter.h"
 #include "LevelPreloadDatabaseLPT.h"
 #include "SettingsLPT.h"
@@ -8,6 +10,8 @@
 #include "Engine/World.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/StreamableManager.h"
+#include "Engine/AssetManager.h"
+#include "Misc/CoreDelegates.h"
 #include "UObject/Package.h"
 #include "SlateWidgetWrapLPT.h"
 
@@ -38,6 +42,23 @@ void ULevelProgressTrackerSubsytem::Initialize(FSubsystemCollectionBase& Collect
 		PreloadDatabaseAsset.Reset();
 	}
 
+	// Warm up the database in the background, so the first transition does not deserialize it on the game thread.
+	RequestPreloadDatabaseLoad();
+
+	LoadLearnedTransitions();
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ULevelProgressTrackerSubsytem::TickLPT));
+
+	// Watchdog
+	if (GEngine)
+	{
+		TravelFailureHandle = GEngine->OnTravelFailure().AddUObject(this, &ULevelProgressTrackerSubsytem::OnTravelFailure);
+	}
+#if !UE_BUILD_SHIPPING
+	SyncLoadPackageHandle = FCoreDelegates::OnSyncLoadPackage.AddUObject(this, &ULevelProgressTrackerSubsytem::OnSyncLoadPackage);
+	AsyncLoadingFlushHandle = FCoreDelegates::OnAsyncLoadingFlush.AddUObject(this, &ULevelProgressTrackerSubsytem::OnAsyncLoadingFlush);
+#endif
+
 	// Subscribe to be notified when the global level load is complete
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(
 		this,
@@ -48,10 +69,36 @@ void ULevelProgressTrackerSubsytem::Initialize(FSubsystemCollectionBase& Collect
 void ULevelProgressTrackerSubsytem::Deinitialize()
 {
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	if (GEngine)
+	{
+		GEngine->OnTravelFailure().Remove(TravelFailureHandle);
+	}
+	FCoreDelegates::OnSyncLoadPackage.Remove(SyncLoadPackageHandle);
+	FCoreDelegates::OnAsyncLoadingFlush.Remove(AsyncLoadingFlushHandle);
+
+	// Releasing prefetch
+	CancelSpeculativePrefetch();
+	SaveLearnedTransitions();
+	StopMissingAssetRecording();
+	CancelOverfetchAnalysis();
+
+	// Releasing database
+	PendingDatabaseLevels.Reset();
+	if (PreloadDatabaseHandle.IsValid())
+	{
+		PreloadDatabaseHandle->CancelHandle();
+		PreloadDatabaseHandle->ReleaseHandle();
+		PreloadDatabaseHandle.Reset();
+	}
 
 	// Clearing delegates
 	OnLevelLoadProgressLPT.Clear();
 	OnLevelLoadedLPT.Clear();
+	OnLevelLoadProgressNativeLPT.Clear();
+	OnLevelLoadedNativeLPT.Clear();
 
 	// Clearing widgets
 	RemoveSlateWidgetLPT();
@@ -64,21 +111,141 @@ void ULevelProgressTrackerSubsytem::Deinitialize()
 
 #pragma endregion SUBSYSTEM
 
+#pragma region DATABASE
+void ULevelProgressTrackerSubsytem::RequestPreloadDatabaseLoad()
+{
+	if (PreloadDatabaseAsset.IsNull())
+	{
+		return;
+	}
+
+	// Already requested and still loading.
+	if (PreloadDatabaseHandle.IsValid() && PreloadDatabaseHandle->IsLoadingInProgress())
+	{
+		return;
+	}
+
+	if (PreloadDatabaseHandle.IsValid())
+	{
+		PreloadDatabaseHandle->ReleaseHandle();
+		PreloadDatabaseHandle.Reset();
+	}
+
+	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+		PreloadDatabaseAsset.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(
+			this,
+			&ULevelProgressTrackerSubsytem::OnPreloadDatabaseLoaded),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+
+	if (!Handle.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (RequestPreloadDatabaseLoad): Failed to request preload database '%s'."),
+			*PreloadDatabaseAsset.ToString()
+		);
+
+		OnPreloadDatabaseLoaded();
+		return;
+	}
+
+	// The callback runs immediately when the database is already resident. Keep the handle only while it is still needed.
+	if (Handle->IsLoadingInProgress() || GetDefault<ULevelProgressTrackerSettings>()->bKeepPreloadDatabaseLoaded)
+	{
+		PreloadDatabaseHandle = Handle;
+	}
+	else
+	{
+		Handle->ReleaseHandle();
+	}
+}
+
+void ULevelProgressTrackerSubsytem::OnPreloadDatabaseLoaded()
+{
+	const bool bDatabaseLoaded = PreloadDatabaseAsset.Get() != nullptr;
+	if (!bDatabaseLoaded)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadDatabaseLoaded): Preload database '%s' could not be loaded."),
+			*PreloadDatabaseAsset.ToString()
+		);
+	}
+
+	// Resume preloads queued while the database was loading.
+	TArray<FName> PendingLevels = MoveTemp(PendingDatabaseLevels);
+	PendingDatabaseLevels.Reset();
+
+	for (const FName PackagePath : PendingLevels)
+	{
+		TSharedPtr<FLevelState> LevelState = LevelLoadedMap.FindRef(PackagePath);
+		if (!LevelState.IsValid())
+		{
+			continue;
+		}
+
+		TSharedRef<FLevelState> LevelStateRef = LevelState.ToSharedRef();
+		const bool bIsStreamingLevel = LevelStateRef->LoadMethod == ELevelLoadMethod::LevelStreaming;
+		if (bDatabaseLoaded)
+		{
+			StartPreloadingResources(PackagePath, LevelStateRef->LevelSoftPtr, LevelStateRef, bIsStreamingLevel, LevelStateRef->LoadOptions);
+		}
+		else
+		{
+			StartLevelWithoutPreload(PackagePath, bIsStreamingLevel, LevelStateRef);
+		}
+	}
+
+	if (PreloadDatabaseHandle.IsValid() && !GetDefault<ULevelProgressTrackerSettings>()->bKeepPreloadDatabaseLoaded)
+	{
+		PreloadDatabaseHandle->ReleaseHandle();
+		PreloadDatabaseHandle.Reset();
+	}
+}
+
+bool ULevelProgressTrackerSubsytem::IsPreloadDatabaseReadyLPT() const
+{
+	return PreloadDatabaseAsset.Get() != nullptr;
+}
+
+#pragma endregion DATABASE
+
 void ULevelProgressTrackerSubsytem::OnPostLoadMapWithWorld(UWorld* LoadedWorld)
 {
+	LPT_TRACE_SCOPE(LPT_OnPostLoadMapWithWorld);
+	LPT_SCOPE_CALLBACK_STATS();
+
 	if (LoadedWorld && LoadedWorld == GetWorld())
 	{
+		// A prefetch that was not adopted by a transition is stale on the new map, so are recordings of the previous map.
+		CancelSpeculativePrefetch();
+		StopMissingAssetRecording();
+		CancelOverfetchAnalysis();
+		PrefetchIdleTime = 0.f;
+		SaveLearnedTransitions();
+
 		FString OriginalPackageName = LoadedWorld->GetOutermost()->GetName();
 		// Defining the method for forming the package name path
 		FName PackageName = CheckingPIE() ? FName(*UWorld::RemovePIEPrefix(OriginalPackageName)) : FName(*OriginalPackageName);
 		TSharedPtr<FLevelState> LevelState = LevelLoadedMap.FindRef(PackageName);
+
+		// The preload set of the new map is compared with the next level on the following transition.
+		ResidentPreloadPaths.Reset();
+
 		// Reset handler if level is not streaming
 		if (LevelState && LevelState->LoadMethod != ELevelLoadMethod::LevelStreaming)
 		{
+			ResidentPreloadPaths.Append(LevelState->SelectedPreloadPaths);
+			LevelState->SelectedPreloadPaths.Empty();
+			StartMissingAssetRecording(PackageName);
+			StartOverfetchAnalysis(PackageName, LevelState->SessionReport.SelectedCollections);
+
 			// Releasing resource preload handles and finishing tracking.
 			ReleaseLevelStateHandles(LevelState.ToSharedRef(), false);
+			FinishLoadSessionReport(LevelState.ToSharedRef());
 
 			// Streaming level loading notification
+			TraceLPT::LevelLoaded(LevelState->LoadHandle.Id, LevelState->LevelName);
+			OnLevelLoadedNativeLPT.Broadcast(LevelState->LoadHandle);
 			OnLevelLoadedLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName);
 			// Clear memory from unnecessary data
 			LevelLoadedMap.Remove(PackageName);
@@ -110,6 +277,57 @@ void ULevelProgressTrackerSubsytem::RemoveSlateWidgetLPT()
 	}
 }
 
+void ULevelProgressTrackerSubsytem::UpdateRuntimeStats() const
+{
+#if STATS || CSV_PROFILER
+	int32 OutstandingChunks = 0;
+	int32 HeldPreloadAssets = 0;
+
+	for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+	{
+		const TSharedPtr<FLevelState>& LevelState = Level.Value;
+		if (!LevelState.IsValid())
+		{
+			continue;
+		}
+
+		for (const FLevelPreloadChunkLPT& Chunk : LevelState->InFlightChunks)
+		{
+			OutstandingChunks += Chunk.bCompleted ? 0 : 1;
+		}
+
+		if (LevelState->Handle.IsValid() || !LevelState->ChunkHandles.IsEmpty())
+		{
+			HeldPreloadAssets += LevelState->LoadedAssets + LevelState->SharedAssetCount;
+		}
+	}
+
+	StatsLPT::SetFrameGauges(LevelLoadedMap.Num(), OutstandingChunks, HeldPreloadAssets);
+#endif
+}
+
+float ULevelProgressTrackerSubsytem::GetLevelLoadProgressLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, int32& LoadedAssets, int32& TotalAssets) const
+{
+	LoadedAssets = 0;
+	TotalAssets = 0;
+
+	if (LevelSoftPtr.IsNull())
+	{
+		return 0.f;
+	}
+
+	const FName PackagePath = FName(*LevelSoftPtr.ToSoftObjectPath().GetLongPackageName());
+	const TSharedPtr<FLevelState> LevelState = LevelLoadedMap.FindRef(PackagePath);
+	if (!LevelState.IsValid())
+	{
+		return 0.f;
+	}
+
+	LoadedAssets = LevelState->LoadedAssets;
+	TotalAssets = LevelState->TotalAssets;
+	return LevelState->Progress;
+}
+
 bool ULevelProgressTrackerSubsytem::CheckingPIE()
 {
 	UWorld* World = GetWorld();
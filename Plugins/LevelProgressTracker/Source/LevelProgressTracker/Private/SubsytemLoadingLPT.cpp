@@ -1,152 +1,230 @@
 // Pavel Gornostaev <https://github.com/Pavreally>
 
 #include "SubsytemLPT.h"
+#include "StatsLPT.h"
+#include "TraceLPT.h"
 #include "LevelPreloadDatabaseLPT.h"
 #include "AssetCollectionDataLPT.h"
 #include "AssetFilterSettingsLPT.h"
 #include "Engine/StreamableManager.h"
+#include "HAL/PlatformTime.h"
 #include "Engine/AssetManager.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "PreloadSelectionLPT.h"
+#include "SettingsLPT.h"
 
 namespace
 {
-	const FName DefaultCollectionKey(TEXT("Default"));
+	TAutoConsoleVariable<int32> CVarForcePreloadMode(
+		TEXT("LPT.ForcePreloadMode"),
+		0,
+		TEXT("Overrides the preload mode of level filter settings. 0: use filter settings, 1: chunked, 2: aggregated, 3: package async."),
+		ECVF_Default
+	);
+}
 
-	void SelectCollectionsForLoad(
-		const FLevelPreloadEntryLPT& LevelEntry,
-		const FLPTLoadOptions& LoadOptions,
-		TArray<UAssetCollectionDataLPT*>& OutSelectedCollections)
+FLPTLoadHandle ULevelProgressTrackerSubsytem::OpenLevelLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources)
+{
+	return OpenLevelLPT(LevelSoftPtr, PreloadingResources, FLPTLoadOptions());
+}
+
+FLPTLoadHandle ULevelProgressTrackerSubsytem::OpenLevelLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources, const FLPTLoadOptions& LoadOptions)
+{
+	if (LevelSoftPtr.IsNull())
 	{
-		OutSelectedCollections.Reset();
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OpenLevelLPT): Invalid level pointer."));
 
-		TSet<FSoftObjectPath> UniqueCollectionPaths;
-		TSet<FName> RequestedCollectionKeys;
-		RequestedCollectionKeys.Reserve(LoadOptions.CollectionKeys.Num());
-		for (const FName RequestedKey : LoadOptions.CollectionKeys)
-		{
-			if (!RequestedKey.IsNone())
-			{
-				RequestedCollectionKeys.Add(RequestedKey);
-			}
-		}
+		return FLPTLoadHandle();
+	}
 
-		const bool bUseCollectionKeySelection = RequestedCollectionKeys.Num() > 0;
-		const bool bUseGroupTagSelection = !bUseCollectionKeySelection && !LoadOptions.GroupTags.IsEmpty();
+	// Preloads the target level's resources, waits for all resources to load, and starts the level itself.
+	return AsyncLoadAssetsLPT(LevelSoftPtr, PreloadingResources, false, FLevelInstanceState(), LoadOptions);
+}
 
-		for (const TSoftObjectPtr<UAssetCollectionDataLPT>& CollectionRef : LevelEntry.Collections)
-		{
-			const FSoftObjectPath CollectionPath = CollectionRef.ToSoftObjectPath();
-			if (!CollectionPath.IsValid() || UniqueCollectionPaths.Contains(CollectionPath))
-			{
-				continue;
-			}
+FLPTLoadHandle ULevelProgressTrackerSubsytem::LoadLevelInstanceLPT(TSoftObjectPtr<UWorld> LevelSoftPtr, const FTransform Transform, TSubclassOf<ULevelStreamingDynamic> OptionalLevelStreamingClass, bool bLoadAsTempPackage, bool PreloadingResources)
+{
+	return LoadLevelInstanceLPT(LevelSoftPtr, Transform, OptionalLevelStreamingClass, bLoadAsTempPackage, PreloadingResources, FLPTLoadOptions());
+}
 
-			UAssetCollectionDataLPT* CollectionAsset = CollectionRef.LoadSynchronous();
-			if (!CollectionAsset)
-			{
-				continue;
-			}
+FLPTLoadHandle ULevelProgressTrackerSubsytem::LoadLevelInstanceLPT(TSoftObjectPtr<UWorld> LevelSoftPtr, const FTransform Transform, TSubclassOf<ULevelStreamingDynamic> OptionalLevelStreamingClass, bool bLoadAsTempPackage, bool PreloadingResources, const FLPTLoadOptions& LoadOptions)
+{
+	if (LevelSoftPtr.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (LoadLevelInstanceLPT): Invalid level pointer."));
 
-			bool bShouldUseCollection = false;
-			if (bUseCollectionKeySelection)
-			{
-				bShouldUseCollection = RequestedCollectionKeys.Contains(CollectionAsset->CollectionKey);
-			}
-			else if (bUseGroupTagSelection)
-			{
-				bShouldUseCollection = CollectionAsset->GroupTags.HasAny(LoadOptions.GroupTags);
-			}
-			else
-			{
-				bShouldUseCollection = CollectionAsset->CollectionKey == DefaultCollectionKey;
-			}
+		return FLPTLoadHandle();
+	}
 
-			if (!bShouldUseCollection)
-			{
-				continue;
-			}
+	FLevelInstanceState LevelInstanceState;
+	LevelInstanceState.Transform = Transform;
+	LevelInstanceState.OptionalLevelStreamingClass = OptionalLevelStreamingClass;
+	LevelInstanceState.bLoadAsTempPackage = bLoadAsTempPackage;
 
-			UniqueCollectionPaths.Add(CollectionPath);
-			OutSelectedCollections.Add(CollectionAsset);
-		}
+	// Preloads the target level's resources, waits for all resources to load, and starts the level itself.
+	return AsyncLoadAssetsLPT(LevelSoftPtr, PreloadingResources, true, LevelInstanceState, LoadOptions);
+}
+
+bool ULevelProgressTrackerSubsytem::CancelLevelLoadLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr)
+{
+	if (LevelSoftPtr.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (CancelLevelLoadLPT): Invalid level pointer."));
+
+		return false;
 	}
 
-	void MergeCollectionAssetLists(
-		const TArray<UAssetCollectionDataLPT*>& Collections,
-		TArray<FSoftObjectPath>& OutMergedPaths)
+	const FName PackagePath = FName(*LevelSoftPtr.ToSoftObjectPath().GetLongPackageName());
+	TSharedPtr<FLevelState> LevelState = LevelLoadedMap.FindRef(PackagePath);
+	if (!LevelState.IsValid())
 	{
-		OutMergedPaths.Reset();
+		UE_LOG(LogTemp, Warning, TEXT("LPT (CancelLevelLoadLPT): The level \"%s\" is not being loaded."), *PackagePath.ToString());
 
-		TSet<FSoftObjectPath> UniquePaths;
-		for (const UAssetCollectionDataLPT* CollectionAsset : Collections)
-		{
-			if (!CollectionAsset)
-			{
-				continue;
-			}
+		return false;
+	}
 
-			for (const FSoftObjectPath& AssetPath : CollectionAsset->AssetList)
-			{
-				if (!AssetPath.IsValid() || UniquePaths.Contains(AssetPath))
-				{
-					continue;
-				}
+	if (LevelState->bLevelRequested)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (CancelLevelLoadLPT): The level \"%s\" has already been requested and can no longer be cancelled."), *LevelState->LevelName.ToString());
 
-				UniquePaths.Add(AssetPath);
-				OutMergedPaths.Add(AssetPath);
-			}
-		}
+		return false;
 	}
-}
 
-void ULevelProgressTrackerSubsytem::OpenLevelLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources)
-{
-	OpenLevelLPT(LevelSoftPtr, PreloadingResources, FLPTLoadOptions());
+	CancelLevelState(PackagePath, LevelState.ToSharedRef());
+	return true;
 }
 
-void ULevelProgressTrackerSubsytem::OpenLevelLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources, const FLPTLoadOptions& LoadOptions)
+FLPTLoadHandle ULevelProgressTrackerSubsytem::RetargetLevelLoadLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, const TSoftObjectPtr<UWorld> NewLevelSoftPtr, bool PreloadingResources, const FLPTLoadOptions& LoadOptions)
 {
-	if (LevelSoftPtr.IsNull())
+	if (LevelSoftPtr.IsNull() || NewLevelSoftPtr.IsNull())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("LPT (OpenLevelLPT): Invalid level pointer."));
+		UE_LOG(LogTemp, Warning, TEXT("LPT (RetargetLevelLoadLPT): Invalid level pointer."));
 
-		return;
+		return FLPTLoadHandle();
 	}
 
-	// Preloads the target level's resources, waits for all resources to load, and starts the level itself.
-	AsyncLoadAssetsLPT(LevelSoftPtr, PreloadingResources, false, FLevelInstanceState(), LoadOptions);
+	const FName PackagePath = FName(*LevelSoftPtr.ToSoftObjectPath().GetLongPackageName());
+	TSharedPtr<FLevelState> LevelState = LevelLoadedMap.FindRef(PackagePath);
+	if (!LevelState.IsValid() || LevelState->bLevelRequested)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (RetargetLevelLoadLPT): The level \"%s\" is not being loaded or has already been requested."), *PackagePath.ToString());
+
+		return FLPTLoadHandle();
+	}
+
+	const bool bIsStreamingLevel = LevelState->LoadMethod == ELevelLoadMethod::LevelStreaming;
+	const FLevelInstanceState LevelInstanceState = LevelState->LevelInstanceState;
+
+	// Hold the already loaded part of the old preload until the new level has selected its assets.
+	TArray<FSoftObjectPath> ResidentPaths;
+	ResidentPaths.Reserve(LevelState->SelectedPreloadPaths.Num());
+	for (const FSoftObjectPath& AssetPath : LevelState->SelectedPreloadPaths)
+	{
+		if (AssetPath.ResolveObject())
+		{
+			ResidentPaths.Add(AssetPath);
+		}
+	}
+
+	if (PreloadingResources && !ResidentPaths.IsEmpty())
+	{
+		FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+		RetargetCarryHandle = StreamableManager.RequestAsyncLoad(
+			ResidentPaths,
+			FStreamableDelegate(),
+			FStreamableManager::AsyncLoadHighPriority
+		);
+
+		if (RetargetCarryHandle.IsValid())
+		{
+			RetargetCarryPaths.Append(ResidentPaths);
+		}
+	}
+
+	CancelLevelState(PackagePath, LevelState.ToSharedRef());
+
+	// The new level state takes over the carried assets in AsyncLoadAssetsLPT.
+	const FLPTLoadHandle LoadHandle = AsyncLoadAssetsLPT(NewLevelSoftPtr, PreloadingResources, bIsStreamingLevel, LevelInstanceState, LoadOptions);
+
+	if (RetargetCarryHandle.IsValid())
+	{
+		RetargetCarryHandle->ReleaseHandle();
+		RetargetCarryHandle.Reset();
+	}
+	RetargetCarryPaths.Reset();
+
+	return LoadHandle;
 }
 
-void ULevelProgressTrackerSubsytem::LoadLevelInstanceLPT(TSoftObjectPtr<UWorld> LevelSoftPtr, const FTransform Transform, TSubclassOf<ULevelStreamingDynamic> OptionalLevelStreamingClass, bool bLoadAsTempPackage, bool PreloadingResources)
+void ULevelProgressTrackerSubsytem::CancelLevelState(FName PackagePath, TSharedRef<FLevelState> LevelState)
 {
-	LoadLevelInstanceLPT(LevelSoftPtr, Transform, OptionalLevelStreamingClass, bLoadAsTempPackage, PreloadingResources, FLPTLoadOptions());
+	// Stop queued chunks before cancelling, so no callback requests new ones.
+	LevelState->bCancelled = true;
+	LevelState->bPreloadCompleted = true;
+	LevelState->bScheduled = false;
+	LevelState->NextPreloadPathIndex = LevelState->PreloadPaths.Num();
+
+	PendingDatabaseLevels.Remove(PackagePath);
+	ReleaseLevelStateHandles(LevelState, true);
+
+	LevelState->PreloadPaths.Reset();
+	LevelState->PreloadCostWeights.Reset();
+	LevelState->PreloadTiers.Reset();
+	LevelState->PendingCostIndices.Reset();
+
+	LevelLoadedMap.Remove(PackagePath);
+	FinishLoadSessionReport(LevelState);
+
+	UE_LOG(LogTemp, Log, TEXT("LPT (CancelLevelState): Loading of level \"%s\" was cancelled."), *LevelState->LevelName.ToString());
+
+	// Freed global chunk slots go to the remaining loads.
+	SchedulePreloadChunks();
 }
 
-void ULevelProgressTrackerSubsytem::LoadLevelInstanceLPT(TSoftObjectPtr<UWorld> LevelSoftPtr, const FTransform Transform, TSubclassOf<ULevelStreamingDynamic> OptionalLevelStreamingClass, bool bLoadAsTempPackage, bool PreloadingResources, const FLPTLoadOptions& LoadOptions)
+void ULevelProgressTrackerSubsytem::AdoptRetargetedAssets(TSharedRef<FLevelState> LevelState)
 {
-	if (LevelSoftPtr.IsNull())
+	if (!LevelState->RetargetHandle.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("LPT (LoadLevelInstanceLPT): Invalid level pointer."));
-
 		return;
 	}
 
-	FLevelInstanceState LevelInstanceState;
-	LevelInstanceState.Transform = Transform;
-	LevelInstanceState.OptionalLevelStreamingClass = OptionalLevelStreamingClass;
-	LevelInstanceState.bLoadAsTempPackage = bLoadAsTempPackage;
+	TArray<FSoftObjectPath> OverlapPaths;
+	for (const FSoftObjectPath& AssetPath : LevelState->SelectedPreloadPaths)
+	{
+		if (LevelState->RetargetPaths.Contains(AssetPath))
+		{
+			OverlapPaths.Add(AssetPath);
+		}
+	}
 
-	// Preloads the target level's resources, waits for all resources to load, and starts the level itself.
-	AsyncLoadAssetsLPT(LevelSoftPtr, PreloadingResources, true, LevelInstanceState, LoadOptions);
+	// Overlapping assets are resident, so the request completes immediately and only adds references.
+	if (!OverlapPaths.IsEmpty())
+	{
+		FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+		TSharedPtr<FStreamableHandle> OverlapHandle = StreamableManager.RequestAsyncLoad(
+			OverlapPaths,
+			FStreamableDelegate(),
+			FStreamableManager::AsyncLoadHighPriority
+		);
+
+		if (OverlapHandle.IsValid())
+		{
+			LevelState->ChunkHandles.Add(OverlapHandle);
+		}
+	}
+
+	LevelState->RetargetHandle->ReleaseHandle();
+	LevelState->RetargetHandle.Reset();
+	LevelState->RetargetPaths.Reset();
 }
 
-void ULevelProgressTrackerSubsytem::AsyncLoadAssetsLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources, bool bIsStreamingLevel, FLevelInstanceState LevelInstanceState, const FLPTLoadOptions& LoadOptions)
+FLPTLoadHandle ULevelProgressTrackerSubsytem::AsyncLoadAssetsLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources, bool bIsStreamingLevel, FLevelInstanceState LevelInstanceState, const FLPTLoadOptions& LoadOptions)
 {
 	if (LevelSoftPtr.IsNull())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("LPT (AsyncLoadAssetsLPT): Invalid level pointer."));
 
-		return;
+		return FLPTLoadHandle();
 	}
 
 	FName PackagePath = FName(*LevelSoftPtr.ToSoftObjectPath().GetLongPackageName());
@@ -156,18 +234,34 @@ void ULevelProgressTrackerSubsytem::AsyncLoadAssetsLPT(const TSoftObjectPtr<UWor
 	{
 		UE_LOG(LogTemp, Warning, TEXT("LPT (AsyncLoadAssetsLPT): The requested level \"%s\" is currently loading or has loaded."), *TargetLevelName);
 
-		return;
+		return FLPTLoadHandle();
 	}
 
+	// Assets loaded or held by the new request do not belong to the recorded or analyzed level.
+	StopMissingAssetRecording();
+	CancelOverfetchAnalysis();
+
 	// Init load stat
 	TSharedRef<FLevelState> LevelState = MakeShared<FLevelState>();
 	LevelState->LevelSoftPtr = LevelSoftPtr;
 	LevelState->LevelName = FName(TargetLevelName);
+	LevelState->LoadHandle.Id = ++LastLoadHandleId;
+	LevelState->RequestTime = FPlatformTime::Seconds();
+	LevelState->LastProgressTime = LevelState->RequestTime;
 	LevelState->TotalAssets = 0;
 	LevelState->LoadedAssets = 0;
 	LevelState->LevelInstanceState = LevelInstanceState;
 	LevelState->LoadOptions = LoadOptions;
 
+	// Assets carried over by RetargetLevelLoadLPT.
+	if (PreloadingResources && RetargetCarryHandle.IsValid())
+	{
+		LevelState->RetargetHandle = MoveTemp(RetargetCarryHandle);
+		LevelState->RetargetPaths = MoveTemp(RetargetCarryPaths);
+		RetargetCarryHandle.Reset();
+		RetargetCarryPaths.Reset();
+	}
+
 	if (bIsStreamingLevel)
 	{
 		LevelState->LoadMethod = ELevelLoadMethod::LevelStreaming;
@@ -175,6 +269,20 @@ void ULevelProgressTrackerSubsytem::AsyncLoadAssetsLPT(const TSoftObjectPtr<UWor
 
 	LevelLoadedMap.Add(PackagePath, LevelState);
 
+	if (!bIsStreamingLevel)
+	{
+		RecordLevelTransition(PackagePath);
+	}
+
+	// A prefetch of another level would compete with this transition for IO.
+	if (!PrefetchState.PackagePath.IsNone() && PrefetchState.PackagePath != PackagePath)
+	{
+		CancelSpeculativePrefetch();
+	}
+
+	// The state may finish synchronously, so keep the handle for the caller.
+	const FLPTLoadHandle LoadHandle = LevelState->LoadHandle;
+
 	if (PreloadingResources)
 	{
 		StartPreloadingResources(PackagePath, LevelSoftPtr, LevelState, bIsStreamingLevel, LevelState->LoadOptions);
@@ -183,11 +291,23 @@ void ULevelProgressTrackerSubsytem::AsyncLoadAssetsLPT(const TSoftObjectPtr<UWor
 	{
 		StartLevelLPT(PackagePath, bIsStreamingLevel, LevelState);
 	}
+
+	return LoadHandle;
 }
 
 void ULevelProgressTrackerSubsytem::StartPreloadingResources(FName PackagePath, const TSoftObjectPtr<UWorld>& LevelSoftPtr, TSharedRef<FLevelState>& LevelState, bool bIsStreamingLevel, const FLPTLoadOptions& LoadOptions)
 {
-	ULevelPreloadDatabaseLPT* PreloadDatabase = PreloadDatabaseAsset.LoadSynchronous();
+	LPT_TRACE_SCOPE(LPT_StartPreloadingResources);
+
+	ULevelPreloadDatabaseLPT* PreloadDatabase = PreloadDatabaseAsset.Get();
+	if (!PreloadDatabase && !PreloadDatabaseAsset.IsNull())
+	{
+		// The database is still warming up or was collected. Queue the level instead of loading the database synchronously.
+		PendingDatabaseLevels.AddUnique(PackagePath);
+		RequestPreloadDatabaseLoad();
+		return;
+	}
+
 	if (!PreloadDatabase)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("LPT (StartPreloadingResources): Preload database '%s' is missing. Falling back to level-only loading for '%s'."),
@@ -195,10 +315,7 @@ void ULevelProgressTrackerSubsytem::StartPreloadingResources(FName PackagePath,
 			*PackagePath.ToString()
 		);
 
-		LevelState->TotalAssets = 1;
-		LevelState->LoadedAssets = 1;
-		OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, 1.f, LevelState->LoadedAssets, LevelState->TotalAssets);
-		StartLevelLPT(PackagePath, bIsStreamingLevel, LevelState);
+		StartLevelWithoutPreload(PackagePath, bIsStreamingLevel, LevelState);
 		return;
 	}
 
@@ -209,41 +326,172 @@ void ULevelProgressTrackerSubsytem::StartPreloadingResources(FName PackagePath,
 			*PackagePath.ToString()
 		);
 
-		LevelState->TotalAssets = 1;
-		LevelState->LoadedAssets = 1;
-		OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, 1.f, LevelState->LoadedAssets, LevelState->TotalAssets);
-		StartLevelLPT(PackagePath, bIsStreamingLevel, LevelState);
+		StartLevelWithoutPreload(PackagePath, bIsStreamingLevel, LevelState);
+		return;
+	}
+
+	// Selected collection assets are requested in one batched async request instead of being loaded synchronously
+	// on the game thread during the transition. With a baked runtime record selection and chunk settings come from
+	// the database, so filter settings and unselected collections are never loaded. A baked merged list of the
+	// selection needs no collection assets at all.
+	// The database itself is part of the request so the handle keeps it referenced until selection is done.
+	const bool bUseRuntimeRecord = LevelEntry->RuntimeRecord.bBaked && !LevelState->bRuntimeRecordRejected;
+	TArray<FSoftObjectPath> MetadataPaths;
+	if (!bUseRuntimeRecord || !PreloadSelectionLPT::FindSelectedMergedList(*LevelEntry, LoadOptions))
+	{
+		PreloadSelectionLPT::SelectCollectionPathsForLoad(*LevelEntry, LoadOptions, MetadataPaths, bUseRuntimeRecord);
+	}
+	MetadataPaths.Insert(PreloadDatabaseAsset.ToSoftObjectPath(), 0);
+
+	const FSoftObjectPath FilterSettingsPath = LevelEntry->FilterSettings.ToSoftObjectPath();
+	if (!bUseRuntimeRecord && FilterSettingsPath.IsValid())
+	{
+		MetadataPaths.AddUnique(FilterSettingsPath);
+	}
+
+	const bool bAllMetadataResident = !MetadataPaths.ContainsByPredicate([](const FSoftObjectPath& MetadataPath)
+	{
+		return MetadataPath.ResolveObject() == nullptr;
+	});
+
+	if (bAllMetadataResident)
+	{
+		OnPreloadCollectionsLoaded(PackagePath, bIsStreamingLevel, LevelState);
+		return;
+	}
+
+	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+	TSharedPtr<FStreamableHandle> MetadataHandle = StreamableManager.RequestAsyncLoad(
+		MetadataPaths,
+		FStreamableDelegate::CreateUObject(
+			this,
+			&ULevelProgressTrackerSubsytem::OnPreloadCollectionsLoaded,
+			PackagePath,
+			bIsStreamingLevel,
+			LevelState),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+
+	if (!MetadataHandle.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (StartPreloadingResources): Failed to request collection assets for level '%s'. Falling back to level-only loading."),
+			*PackagePath.ToString()
+		);
+
+		StartLevelWithoutPreload(PackagePath, bIsStreamingLevel, LevelState);
+		return;
+	}
+
+	LevelState->MetadataHandle = MetadataHandle;
+}
+
+void ULevelProgressTrackerSubsytem::OnPreloadCollectionsLoaded(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState)
+{
+	LPT_TRACE_SCOPE(LPT_OnPreloadCollectionsLoaded);
+	LPT_SCOPE_CALLBACK_STATS();
+
+	if (LevelState->bCancelled)
+	{
+		return;
+	}
+
+	const ULevelPreloadDatabaseLPT* PreloadDatabase = PreloadDatabaseAsset.Get();
+	const FLevelPreloadEntryLPT* LevelEntry = PreloadDatabase ? PreloadDatabase->FindEntryByLevel(LevelState->LevelSoftPtr) : nullptr;
+	if (!LevelEntry)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadCollectionsLoaded): Preload entry for level '%s' is no longer available. Falling back to level-only loading."),
+			*PackagePath.ToString()
+		);
+
+		ReleaseMetadataHandle(LevelState);
+		StartLevelWithoutPreload(PackagePath, bIsStreamingLevel, LevelState);
+		return;
+	}
+
+	const FLPTLoadOptions& LoadOptions = LevelState->LoadOptions;
+
+	// Without a merged list the selected collections were loaded, so the record is checked against them. A record
+	// cooked against other collection content would select and merge the wrong assets. Selection starts over from
+	// every collection and the filter settings, the way unbaked entries are handled.
+	const bool bUseRuntimeRecord = LevelEntry->RuntimeRecord.bBaked && !LevelState->bRuntimeRecordRejected;
+	if (bUseRuntimeRecord && !PreloadSelectionLPT::FindSelectedMergedList(*LevelEntry, LoadOptions) && !PreloadSelectionLPT::IsRuntimeRecordCurrent(*LevelEntry, LoadOptions))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadCollectionsLoaded): Runtime record of level '%s' is outdated. Loading every collection for selection."),
+			*PackagePath.ToString()
+		);
+
+		// The stale handle is released after the new request, so the collections it holds stay resident.
+		TSharedPtr<FStreamableHandle> StaleMetadataHandle = MoveTemp(LevelState->MetadataHandle);
+		LevelState->bRuntimeRecordRejected = true;
+		StartPreloadingResources(PackagePath, LevelState->LevelSoftPtr, LevelState, bIsStreamingLevel, LoadOptions);
+		if (StaleMetadataHandle.IsValid())
+		{
+			StaleMetadataHandle->ReleaseHandle();
+		}
 		return;
 	}
 
 	FLPTFilterSettings RuntimeFilterSettings;
-	if (UAssetFilterSettingsLPT* FilterSettingsAsset = LevelEntry->FilterSettings.LoadSynchronous())
+	if (bUseRuntimeRecord)
+	{
+		LevelEntry->RuntimeRecord.CopyChunkSettingsTo(RuntimeFilterSettings);
+	}
+	else if (const UAssetFilterSettingsLPT* FilterSettingsAsset = LevelEntry->FilterSettings.Get())
 	{
 		RuntimeFilterSettings = FilterSettingsAsset->ToFilterSettings();
 	}
+	const ELPTPreloadBackend PreloadBackend = RuntimeFilterSettings.PreloadBackend == ELPTPreloadBackend::ProjectDefault
+		? GetDefault<ULevelProgressTrackerSettings>()->DefaultPreloadBackend
+		: RuntimeFilterSettings.PreloadBackend;
 	LevelState->bUseChunkedPreload = RuntimeFilterSettings.bUseChunkedPreload;
+	LevelState->bUsePackagePreload = PreloadBackend == ELPTPreloadBackend::PackageAsync;
+	if (const int32 ForcedPreloadMode = CVarForcePreloadMode.GetValueOnGameThread())
+	{
+		LevelState->bUseChunkedPreload = ForcedPreloadMode == 1;
+		LevelState->bUsePackagePreload = ForcedPreloadMode == 3;
+	}
 	LevelState->PreloadChunkSize = FMath::Max(1, RuntimeFilterSettings.PreloadChunkSize);
+	LevelState->bUseAdaptiveChunkSize = RuntimeFilterSettings.bUseAdaptiveChunkSize;
+	LevelState->MinAdaptiveChunkSize = FMath::Max(1, RuntimeFilterSettings.MinAdaptiveChunkSize);
+	LevelState->MaxAdaptiveChunkSize = FMath::Max(LevelState->MinAdaptiveChunkSize, RuntimeFilterSettings.MaxAdaptiveChunkSize);
+	LevelState->TargetChunkLoadTime = FMath::Max(0.01f, RuntimeFilterSettings.TargetChunkLoadTime);
+	if (LevelState->bUseAdaptiveChunkSize)
+	{
+		LevelState->PreloadChunkSize = FMath::Clamp(LevelState->PreloadChunkSize, LevelState->MinAdaptiveChunkSize, LevelState->MaxAdaptiveChunkSize);
+	}
+	LevelState->MaxChunksInFlight = FMath::Max(1, RuntimeFilterSettings.MaxChunksInFlight);
+
+	PreloadSelectionLPT::FPreloadListLPT PreloadList;
+	PreloadSelectionLPT::BuildPreloadList(*LevelEntry, LoadOptions, PreloadList, bUseRuntimeRecord);
+
+	TArray<FSoftObjectPath> Paths = MoveTemp(PreloadList.Paths);
+	TArray<int64> CostWeights = MoveTemp(PreloadList.CostWeights);
+	TArray<ELPTAssetPriorityTier> Tiers = MoveTemp(PreloadList.Tiers);
+	const TArray<FSoftObjectPath>& SelectedCollections = PreloadList.SelectedCollections;
 
-	TArray<UAssetCollectionDataLPT*> SelectedCollections;
-	SelectCollectionsForLoad(*LevelEntry, LoadOptions, SelectedCollections);
+	// Selection is done, collection assets are no longer needed.
+	ReleaseMetadataHandle(LevelState);
 
-	TArray<FSoftObjectPath> Paths;
-	MergeCollectionAssetLists(SelectedCollections, Paths);
+	LevelState->SessionReport.SelectedCollectionKeys = PreloadList.SelectedCollectionKeys;
+	for (const FSoftObjectPath& CollectionPath : SelectedCollections)
+	{
+		LevelState->SessionReport.SelectedCollections.Add(CollectionPath.ToString());
+	}
 
 	if (LoadOptions.CollectionKeys.Num() > 0 && SelectedCollections.IsEmpty())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("LPT (StartPreloadingResources): Requested CollectionKeys not found for level '%s'. No preload assets selected."),
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadCollectionsLoaded): Requested CollectionKeys not found for level '%s'. No preload assets selected."),
 			*PackagePath.ToString());
 	}
 	else if (!LoadOptions.GroupTags.IsEmpty() && SelectedCollections.IsEmpty())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("LPT (StartPreloadingResources): Requested GroupTags did not match any collection for level '%s'. No preload assets selected."),
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadCollectionsLoaded): Requested GroupTags did not match any collection for level '%s'. No preload assets selected."),
 			*PackagePath.ToString());
 	}
 	else if (LoadOptions.CollectionKeys.IsEmpty() && LoadOptions.GroupTags.IsEmpty() && SelectedCollections.IsEmpty())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("LPT (StartPreloadingResources): Default collection '%s' not found for level '%s'. No preload assets selected."),
-			*DefaultCollectionKey.ToString(),
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadCollectionsLoaded): Default collection '%s' not found for level '%s'. No preload assets selected."),
+			*PreloadSelectionLPT::DefaultCollectionKey.ToString(),
 			*PackagePath.ToString()
 		);
 	}
@@ -252,16 +500,86 @@ void ULevelProgressTrackerSubsytem::StartPreloadingResources(FName PackagePath,
 	LevelState->TotalAssets = Paths.Num();
 	LevelState->LoadedAssets = 0;
 	LevelState->PreloadPaths.Reset();
+	LevelState->PreloadCostWeights = MoveTemp(CostWeights);
+	LevelState->PreloadTiers = MoveTemp(Tiers);
+	LevelState->bPreloadPathsInLoadOrder = PreloadList.bInLoadOrder;
+	LevelState->TotalCostWeight = 0;
+	LevelState->LoadedCostWeight = 0;
+	LevelState->CompletedCostWeight = 0;
+	LevelState->PendingCostIndices.Reset();
 	LevelState->NextPreloadPathIndex = 0;
+	LevelState->InFlightChunks.Reset();
+	LevelState->CompletedPreloadPathIndex = 0;
+	LevelState->LastChunkCompletionTime = FPlatformTime::Seconds();
+	LevelState->LastChunkDecreaseTime = 0.0;
+	LevelState->bPreloadCompleted = false;
 	LevelState->ChunkHandles.Reset();
+	LevelState->SelectedPreloadPaths = Paths;
+	LevelState->SharedAssetCount = 0;
+	LevelState->ResidentCostWeight = 0;
+	for (const int64 CostWeight : LevelState->PreloadCostWeights)
+	{
+		LevelState->ResidentCostWeight += CostWeight;
+	}
+	LevelState->bPinned = LoadOptions.bPinPreloadedAssets || PreloadList.bPinResident;
+
+	// Assets prefetched for this level or carried over from a retargeted load stay referenced by the level state.
+	AdoptSpeculativePrefetch(PackagePath, LevelState);
+	AdoptRetargetedAssets(LevelState);
 
+	// Streaming levels are added to the current map, which keeps its assets anyway.
+	if (!bIsStreamingLevel && GetDefault<ULevelProgressTrackerSettings>()->bKeepSharedAssetsBetweenLevels)
+	{
+		KeepSharedPreloadAssets(LevelState, Paths, LevelState->PreloadCostWeights, LevelState->PreloadTiers);
+		LevelState->TotalAssets = Paths.Num();
+	}
+
+	if (GetDefault<ULevelProgressTrackerSettings>()->ResidentMemoryBudgetMB > 0 && !Paths.IsEmpty() && LevelState->PreloadCostWeights.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadCollectionsLoaded): Preload list of level '%s' has no cost weights and is not counted against the resident memory budget. Regenerate its collections."),
+			*PackagePath.ToString()
+		);
+	}
+
+	// Over the budget the preload waits for running preloads, later requests queue behind it.
+	if ((!BudgetDeferredPreloads.IsEmpty() && !LevelState->bPinned) || !EnforceResidentMemoryBudget(LevelState, LevelState->ResidentCostWeight))
+	{
+		UE_LOG(LogTemp, Log, TEXT("LPT (OnPreloadCollectionsLoaded): Preload of level '%s' is deferred by the resident memory budget."),
+			*PackagePath.ToString()
+		);
+
+		LevelState->bBudgetDeferred = true;
+		BudgetDeferredPreloads.Add({ PackagePath, bIsStreamingLevel, LevelState, MoveTemp(Paths) });
+		return;
+	}
+
+	RequestSelectedPreload(PackagePath, bIsStreamingLevel, LevelState, MoveTemp(Paths));
+}
+
+void ULevelProgressTrackerSubsytem::RequestSelectedPreload(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, TArray<FSoftObjectPath> Paths)
+{
 	if (Paths.IsEmpty())
 	{
-		OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, 1.f, 0, 0);
+		BroadcastLevelLoadProgress(LevelState, 1.f, true);
 		StartLevelLPT(PackagePath, bIsStreamingLevel, LevelState);
 		return;
 	}
 
+	for (const int64 CostWeight : LevelState->PreloadCostWeights)
+	{
+		LevelState->TotalCostWeight += CostWeight;
+	}
+
+	if (LevelState->bUsePackagePreload)
+	{
+		LevelState->SessionReport.bPackagePreload = true;
+		StartPackagePreload(PackagePath, bIsStreamingLevel, LevelState, Paths);
+		return;
+	}
+
+	LevelState->SessionReport.bChunkedPreload = LevelState->bUseChunkedPreload;
+	LevelState->SessionReport.InitialChunkSize = LevelState->bUseChunkedPreload ? LevelState->PreloadChunkSize : 0;
+
 	if (LevelState->bUseChunkedPreload)
 	{
 		LevelState->PreloadPaths = MoveTemp(Paths);
@@ -270,69 +588,387 @@ void ULevelProgressTrackerSubsytem::StartPreloadingResources(FName PackagePath,
 		return;
 	}
 
+	// Aggregated mode has no per-asset completion, loaded weight is found by checking which paths became resident.
+	if (LevelState->TotalCostWeight > 0)
+	{
+		LevelState->PreloadPaths = Paths;
+		LevelState->PendingCostIndices.Reserve(Paths.Num());
+		for (int32 PathIndex = 0; PathIndex < Paths.Num(); ++PathIndex)
+		{
+			LevelState->PendingCostIndices.Add(PathIndex);
+		}
+	}
+
 	// Request for async resource loading
-	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
-	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+	StatsLPT::AddAssetsRequested(Paths.Num());
+	const FStreamableDelegate AllAssetsLoadedDelegate = FStreamableDelegate::CreateUObject(
+		this,
+		&ULevelProgressTrackerSubsytem::OnAllAssetsLoaded,
+		PackagePath,
+		bIsStreamingLevel,
+		LevelState);
+
+	if (!LevelState->PreloadTiers.IsEmpty())
+	{
+		if (const TSharedPtr<FStreamableHandle> CombinedHandle = RequestTieredAggregatedPreload(PackagePath, bIsStreamingLevel, LevelState, Paths))
+		{
+			LevelState->Handle = CombinedHandle;
+
+			// Binding fails when every tier was already resident and the combined handle completed on creation.
+			if (!CombinedHandle->BindCompleteDelegate(AllAssetsLoadedDelegate))
+			{
+				OnAllAssetsLoaded(PackagePath, bIsStreamingLevel, LevelState);
+			}
+			return;
+		}
+	}
+	else if (const TSharedPtr<FStreamableHandle> Handle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
 		Paths,
-		FStreamableDelegate::CreateUObject(
+		AllAssetsLoadedDelegate,
+		FStreamableManager::AsyncLoadHighPriority))
+	{
+		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(
 			this,
-			&ULevelProgressTrackerSubsytem::OnAllAssetsLoaded,
+			&ULevelProgressTrackerSubsytem::HandleAssetLoaded,
 			PackagePath,
-			bIsStreamingLevel,
-			LevelState),
-		FStreamableManager::AsyncLoadHighPriority
+			LevelState
+		));
+		LevelState->Handle = Handle;
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadCollectionsLoaded): Failed to create streamable handle for level '%s'."),
+		*PackagePath.ToString()
 	);
 
-	if (Handle.IsValid())
+	StartLevelWithoutPreload(PackagePath, bIsStreamingLevel, LevelState);
+}
+
+TSharedPtr<FStreamableHandle> ULevelProgressTrackerSubsytem::RequestTieredAggregatedPreload(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, const TArray<FSoftObjectPath>& Paths)
+{
+	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+	const int32 PriorityBoost = bIsStreamingLevel ? 0 : PreloadSelectionLPT::ForegroundPreloadPriorityBoost;
+	const TArray<ELPTAssetPriorityTier>& Tiers = LevelState->PreloadTiers;
+
+	// Paths are sorted critical first, so every tier is one contiguous range requested at its own priority.
+	TArray<TSharedPtr<FStreamableHandle>> TierHandles;
+	for (int32 TierStartIndex = 0; TierStartIndex < Paths.Num();)
 	{
-		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(
+		const ELPTAssetPriorityTier Tier = Tiers[TierStartIndex];
+		int32 TierEndIndex = TierStartIndex + 1;
+		while (TierEndIndex < Paths.Num() && Tiers[TierEndIndex] == Tier)
+		{
+			++TierEndIndex;
+		}
+
+		TArray<FSoftObjectPath> TierPaths;
+		TierPaths.Append(Paths.GetData() + TierStartIndex, TierEndIndex - TierStartIndex);
+		TierStartIndex = TierEndIndex;
+
+		const TSharedPtr<FStreamableHandle> TierHandle = StreamableManager.RequestAsyncLoad(
+			MoveTemp(TierPaths),
+			FStreamableDelegate(),
+			PreloadSelectionLPT::GetTierAsyncLoadPriority(Tier) + PriorityBoost
+		);
+
+		if (!TierHandle.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("LPT (RequestTieredAggregatedPreload): Failed to create the %s tier handle for level '%s'."),
+				*UEnum::GetValueAsString(Tier),
+				*PackagePath.ToString()
+			);
+			continue;
+		}
+
+		// Each tier reports to HandleAssetLoaded, which reads the progress summed by the combined handle.
+		TierHandle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(
 			this,
 			&ULevelProgressTrackerSubsytem::HandleAssetLoaded,
 			PackagePath,
 			LevelState
 		));
-		LevelState->Handle = Handle;
+		TierHandles.Add(TierHandle);
 	}
-	else
+
+	if (TierHandles.IsEmpty())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("LPT (StartPreloadingResources): Failed to create streamable handle for level '%s'."),
-			*PackagePath.ToString()
-		);
+		return nullptr;
+	}
 
-		LevelState->TotalAssets = 1;
-		LevelState->LoadedAssets = 1;
-		OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, 1.f, LevelState->LoadedAssets, LevelState->TotalAssets);
-		StartLevelLPT(PackagePath, bIsStreamingLevel, LevelState);
+	// The tier handles keep their assets referenced next to the combined handle and are released with the state.
+	LevelState->ChunkHandles.Append(TierHandles);
+
+	return StreamableManager.CreateCombinedHandle(TierHandles, FString::Printf(TEXT("LPT %s"), *PackagePath.ToString()));
+}
+
+void ULevelProgressTrackerSubsytem::KeepSharedPreloadAssets(TSharedRef<FLevelState> LevelState, TArray<FSoftObjectPath>& InOutPaths, TArray<int64>& InOutCostWeights, TArray<ELPTAssetPriorityTier>& InOutTiers)
+{
+	if (ResidentPreloadPaths.IsEmpty() || InOutPaths.IsEmpty())
+	{
+		return;
 	}
+
+	const bool bHasCostWeights = InOutCostWeights.Num() == InOutPaths.Num();
+	const bool bHasTiers = InOutTiers.Num() == InOutPaths.Num();
+
+	TArray<FSoftObjectPath> SharedPaths;
+	TArray<FSoftObjectPath> DeltaPaths;
+	TArray<int64> DeltaCostWeights;
+	TArray<ELPTAssetPriorityTier> DeltaTiers;
+	DeltaPaths.Reserve(InOutPaths.Num());
+	DeltaCostWeights.Reserve(bHasCostWeights ? InOutPaths.Num() : 0);
+	DeltaTiers.Reserve(bHasTiers ? InOutPaths.Num() : 0);
+
+	for (int32 PathIndex = 0; PathIndex < InOutPaths.Num(); ++PathIndex)
+	{
+		const FSoftObjectPath& AssetPath = InOutPaths[PathIndex];
+
+		// Shared with the current map and still resident.
+		if (ResidentPreloadPaths.Contains(AssetPath) && AssetPath.ResolveObject())
+		{
+			SharedPaths.Add(AssetPath);
+			continue;
+		}
+
+		DeltaPaths.Add(AssetPath);
+		if (bHasCostWeights)
+		{
+			DeltaCostWeights.Add(InOutCostWeights[PathIndex]);
+		}
+		if (bHasTiers)
+		{
+			DeltaTiers.Add(InOutTiers[PathIndex]);
+		}
+	}
+
+	if (SharedPaths.IsEmpty())
+	{
+		return;
+	}
+
+	// Every shared asset is resident, so the request completes immediately and only adds references.
+	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+	TSharedPtr<FStreamableHandle> SharedHandle = StreamableManager.RequestAsyncLoad(
+		SharedPaths,
+		FStreamableDelegate(),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+
+	if (!SharedHandle.IsValid())
+	{
+		return;
+	}
+
+	LevelState->ChunkHandles.Add(SharedHandle);
+	LevelState->SharedAssetCount = SharedPaths.Num();
+
+	InOutPaths = MoveTemp(DeltaPaths);
+	if (bHasCostWeights)
+	{
+		InOutCostWeights = MoveTemp(DeltaCostWeights);
+	}
+	if (bHasTiers)
+	{
+		InOutTiers = MoveTemp(DeltaTiers);
+	}
+}
+
+void ULevelProgressTrackerSubsytem::StartLevelWithoutPreload(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState)
+{
+	LevelState->TotalAssets = 1;
+	LevelState->LoadedAssets = 1;
+	BroadcastLevelLoadProgress(LevelState, 1.f, true);
+	StartLevelLPT(PackagePath, bIsStreamingLevel, LevelState);
 }
 
 void ULevelProgressTrackerSubsytem::StartNextPreloadChunk(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState)
 {
-	if (!LevelState->bUseChunkedPreload)
+	(void)PackagePath;
+	(void)bIsStreamingLevel;
+
+	if (!LevelState->bUseChunkedPreload || LevelState->bPreloadCompleted || LevelState->bCancelled)
 	{
 		return;
 	}
 
-	if (LevelState->NextPreloadPathIndex >= LevelState->PreloadPaths.Num())
+	LevelState->bScheduled = true;
+	SchedulePreloadChunks();
+}
+
+void ULevelProgressTrackerSubsytem::SchedulePreloadChunks()
+{
+	LPT_TRACE_SCOPE(LPT_SchedulePreloadChunks);
+
+	// Chunk callbacks may arrive synchronously while a chunk is requested. Run the pass again instead of nesting it.
+	if (bIsSchedulingPreloadChunks)
 	{
-		OnAllAssetsLoaded(PackagePath, bIsStreamingLevel, LevelState);
+		bPreloadScheduleDirty = true;
 		return;
 	}
 
-	const int32 RemainingAssets = LevelState->PreloadPaths.Num() - LevelState->NextPreloadPathIndex;
-	const int32 ChunkAssetCount = FMath::Clamp(LevelState->PreloadChunkSize, 1, RemainingAssets);
-	const int32 ChunkBaseLoaded = LevelState->LoadedAssets;
+	TGuardValue<bool> SchedulingGuard(bIsSchedulingPreloadChunks, true);
+	const int32 MaxGlobalChunksInFlight = GetDefault<ULevelProgressTrackerSettings>()->MaxGlobalChunksInFlight;
+
+	TArray<TPair<FName, TSharedPtr<FLevelState>>> FinishedStates;
+	do
+	{
+		bPreloadScheduleDirty = false;
+
+		int32 OutstandingChunks = 0;
+		for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+		{
+			if (Level.Value.IsValid() && Level.Value->bScheduled)
+			{
+				OutstandingChunks += Level.Value->InFlightChunks.FilterByPredicate([](const FLevelPreloadChunkLPT& Chunk)
+				{
+					return !Chunk.bCompleted;
+				}).Num();
+			}
+		}
+
+		while (MaxGlobalChunksInFlight <= 0 || OutstandingChunks < MaxGlobalChunksInFlight)
+		{
+			// Foreground OpenLevel loads are served first. Among the rest, the state with the fewest chunks in flight
+			// and then the one served longest ago gets the slot, so concurrent instance loads share IO evenly.
+			FName BestPackagePath;
+			TSharedPtr<FLevelState> BestState;
+			for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+			{
+				const TSharedPtr<FLevelState>& Candidate = Level.Value;
+				if (!Candidate.IsValid() || !Candidate->bScheduled || Candidate->bPreloadCompleted || Candidate->bCancelled ||
+					Candidate->NextPreloadPathIndex >= Candidate->PreloadPaths.Num() ||
+					Candidate->InFlightChunks.Num() >= FMath::Max(1, Candidate->MaxChunksInFlight))
+				{
+					continue;
+				}
+
+				if (!BestState.IsValid())
+				{
+					BestPackagePath = Level.Key;
+					BestState = Candidate;
+					continue;
+				}
+
+				const bool bCandidateForeground = Candidate->LoadMethod != ELevelLoadMethod::LevelStreaming;
+				const bool bBestForeground = BestState->LoadMethod != ELevelLoadMethod::LevelStreaming;
+				if (bCandidateForeground != bBestForeground)
+				{
+					if (bCandidateForeground)
+					{
+						BestPackagePath = Level.Key;
+						BestState = Candidate;
+					}
+					continue;
+				}
+
+				if (Candidate->InFlightChunks.Num() < BestState->InFlightChunks.Num() ||
+					(Candidate->InFlightChunks.Num() == BestState->InFlightChunks.Num() && Candidate->LastScheduledSequence < BestState->LastScheduledSequence))
+				{
+					BestPackagePath = Level.Key;
+					BestState = Candidate;
+				}
+			}
+
+			if (!BestState.IsValid())
+			{
+				break;
+			}
+
+			BestState->LastScheduledSequence = ++PreloadScheduleSequence;
+			RequestPreloadChunk(BestPackagePath, BestState->LoadMethod == ELevelLoadMethod::LevelStreaming, BestState.ToSharedRef());
+			++OutstandingChunks;
+		}
+
+		// States whose last chunk has completed, including chunks that failed synchronously above.
+		for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+		{
+			const TSharedPtr<FLevelState>& LevelState = Level.Value;
+			if (LevelState.IsValid() && LevelState->bScheduled && !LevelState->bPreloadCompleted && !LevelState->bCancelled &&
+				LevelState->InFlightChunks.IsEmpty() &&
+				LevelState->NextPreloadPathIndex >= LevelState->PreloadPaths.Num())
+			{
+				LevelState->bPreloadCompleted = true;
+				LevelState->bScheduled = false;
+				FinishedStates.Emplace(Level.Key, LevelState);
+			}
+		}
+
+		// Completion opens levels and broadcasts events, which may add or remove level states.
+		for (const TPair<FName, TSharedPtr<FLevelState>>& Finished : FinishedStates)
+		{
+			OnAllAssetsLoaded(Finished.Key, Finished.Value->LoadMethod == ELevelLoadMethod::LevelStreaming, Finished.Value.ToSharedRef());
+		}
+
+		if (!FinishedStates.IsEmpty())
+		{
+			FinishedStates.Reset();
+			bPreloadScheduleDirty = true;
+		}
+	}
+	while (bPreloadScheduleDirty);
+}
+
+void ULevelProgressTrackerSubsytem::RequestPreloadChunk(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState)
+{
+	LPT_TRACE_SCOPE(LPT_RequestPreloadChunk);
+
+	const int32 ChunkStartIndex = LevelState->NextPreloadPathIndex;
+	const int32 RemainingAssets = LevelState->PreloadPaths.Num() - ChunkStartIndex;
+	int32 ChunkAssetCount = FMath::Clamp(LevelState->PreloadChunkSize, 1, RemainingAssets);
+
+	// Chunks never span a tier boundary, each request uses the priority of its tier.
+	const ELPTAssetPriorityTier ChunkTier = LevelState->PreloadTiers.IsValidIndex(ChunkStartIndex) ? LevelState->PreloadTiers[ChunkStartIndex] : ELPTAssetPriorityTier::Normal;
+	for (int32 Offset = 1; Offset < ChunkAssetCount; ++Offset)
+	{
+		if (LevelState->PreloadTiers.IsValidIndex(ChunkStartIndex + Offset) && LevelState->PreloadTiers[ChunkStartIndex + Offset] != ChunkTier)
+		{
+			ChunkAssetCount = Offset;
+			break;
+		}
+	}
+
+	const int32 ScheduledAssetCount = ChunkAssetCount;
+
+	// In cook-ordered lists objects of a package are adjacent and packages follow the containers. The chunk is extended
+	// to the end of its last package, so a package is read by one request, up to MaxAdaptiveChunkSize assets.
+	// A chunk size of 1 is kept as configured.
+	const int32 MaxChunkAssetCount = LevelState->bPreloadPathsInLoadOrder && LevelState->PreloadChunkSize > 1
+		? FMath::Max(ScheduledAssetCount, LevelState->MaxAdaptiveChunkSize)
+		: ScheduledAssetCount;
+	while (ChunkAssetCount < MaxChunkAssetCount && ChunkStartIndex + ChunkAssetCount < LevelState->PreloadPaths.Num())
+	{
+		const int32 NextPathIndex = ChunkStartIndex + ChunkAssetCount;
+		if (LevelState->PreloadPaths[NextPathIndex].GetLongPackageFName() != LevelState->PreloadPaths[NextPathIndex - 1].GetLongPackageFName() ||
+			(LevelState->PreloadTiers.IsValidIndex(NextPathIndex) && LevelState->PreloadTiers[NextPathIndex] != ChunkTier))
+		{
+			break;
+		}
+
+		++ChunkAssetCount;
+	}
 
 	TArray<FSoftObjectPath> ChunkPaths;
-	ChunkPaths.Reserve(ChunkAssetCount);
+	ChunkPaths.Append(LevelState->PreloadPaths.GetData() + ChunkStartIndex, ChunkAssetCount);
 
-	for (int32 Index = 0; Index < ChunkAssetCount; ++Index)
+	int64 ChunkCostWeight = 0;
+	for (int32 PathIndex = ChunkStartIndex; PathIndex < ChunkStartIndex + ChunkAssetCount && LevelState->PreloadCostWeights.IsValidIndex(PathIndex); ++PathIndex)
 	{
-		ChunkPaths.Add(LevelState->PreloadPaths[LevelState->NextPreloadPathIndex + Index]);
+		ChunkCostWeight += LevelState->PreloadCostWeights[PathIndex];
 	}
 
 	LevelState->NextPreloadPathIndex += ChunkAssetCount;
 
+	// Register the chunk before requesting it, so an immediate completion callback can still find it.
+	FLevelPreloadChunkLPT& Chunk = LevelState->InFlightChunks.AddDefaulted_GetRef();
+	Chunk.StartIndex = ChunkStartIndex;
+	Chunk.AssetCount = ChunkAssetCount;
+	Chunk.ScheduledAssetCount = ScheduledAssetCount;
+	Chunk.CostWeight = ChunkCostWeight;
+	Chunk.RequestTime = FPlatformTime::Seconds();
+
+	TraceLPT::ChunkRequested(LevelState->LoadHandle.Id, ChunkStartIndex, ChunkAssetCount);
+	StatsLPT::AddAssetsRequested(ChunkAssetCount);
+
 	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
 	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
 		ChunkPaths,
@@ -342,19 +978,19 @@ void ULevelProgressTrackerSubsytem::StartNextPreloadChunk(FName PackagePath, boo
 			PackagePath,
 			bIsStreamingLevel,
 			LevelState,
-			ChunkAssetCount),
-		FStreamableManager::AsyncLoadHighPriority
+			ChunkStartIndex),
+		PreloadSelectionLPT::GetTierAsyncLoadPriority(ChunkTier) + (bIsStreamingLevel ? 0 : PreloadSelectionLPT::ForegroundPreloadPriorityBoost)
 	);
 
 	if (!Handle.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("LPT (StartNextPreloadChunk): Failed to create chunk streamable handle for level '%s'."), *PackagePath.ToString());
-
-		LevelState->LoadedAssets = FMath::Clamp(ChunkBaseLoaded + ChunkAssetCount, 0, LevelState->TotalAssets);
-		const float Progress = LevelState->TotalAssets > 0 ? static_cast<float>(LevelState->LoadedAssets) / LevelState->TotalAssets : 1.f;
-		OnLevelLoadProgressLPT.Broadcast(LevelState->LevelSoftPtr, LevelState->LevelName, Progress, LevelState->LoadedAssets, LevelState->TotalAssets);
+		UE_LOG(LogTemp, Warning, TEXT("LPT (RequestPreloadChunk): Failed to create chunk streamable handle for level '%s'."), *PackagePath.ToString());
 
-		StartNextPreloadChunk(PackagePath, bIsStreamingLevel, LevelState);
+		// Count the failed chunk as processed so the remaining chunks can continue.
+		if (MarkPreloadChunkCompleted(LevelState, ChunkStartIndex, false))
+		{
+			BroadcastLevelLoadProgress(LevelState, LevelState->GetPreloadProgress());
+		}
 		return;
 	}
 
@@ -363,16 +999,36 @@ void ULevelProgressTrackerSubsytem::StartNextPreloadChunk(FName PackagePath, boo
 		&ULevelProgressTrackerSubsytem::HandleChunkAssetLoaded,
 		PackagePath,
 		LevelState,
-		ChunkBaseLoaded,
+		ChunkStartIndex,
 		ChunkAssetCount
 	));
 
+	if (FLevelPreloadChunkLPT* PendingChunk = LevelState->InFlightChunks.FindByPredicate([ChunkStartIndex](const FLevelPreloadChunkLPT& InFlightChunk)
+		{
+			return InFlightChunk.StartIndex == ChunkStartIndex;
+		}))
+	{
+		PendingChunk->Handle = Handle;
+	}
+
 	LevelState->ChunkHandles.Add(Handle);
 	LevelState->Handle = Handle;
 }
 
 void ULevelProgressTrackerSubsytem::StartLevelLPT(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState)
 {
+	LPT_TRACE_SCOPE(LPT_StartLevelLPT);
+
+	if (LevelState->bCancelled)
+	{
+		return;
+	}
+
+	LevelState->bLevelRequested = true;
+	LevelState->LevelRequestTime = FPlatformTime::Seconds();
+	TraceLPT::LevelRequested(LevelState->LoadHandle.Id, LevelState->LevelName, bIsStreamingLevel);
+	StatsLPT::SetRequestToOpenTime(FPlatformTime::Seconds() - LevelState->RequestTime);
+
 	if (bIsStreamingLevel)
 	{
 		// Load Level Instance
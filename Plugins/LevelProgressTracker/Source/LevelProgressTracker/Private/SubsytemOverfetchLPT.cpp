@@ -0,0 +1,209 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "SubsytemLPT.h"
+#include "AssetCollectionDataLPT.h"
+#include "LevelPreloadAssetFilter.h"
+#include "SettingsLPT.h"
+#include "Dom/JsonObject.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+void ULevelProgressTrackerSubsytem::StartOverfetchAnalysis(FName LevelPackage, const TArray<FString>& CollectionPaths)
+{
+#if !UE_BUILD_SHIPPING
+	CancelOverfetchAnalysis();
+
+	const ULevelProgressTrackerSettings* Settings = GetDefault<ULevelProgressTrackerSettings>();
+	if (!Settings->bAnalyzePreloadOverfetch || LevelPackage.IsNone() || CollectionPaths.IsEmpty())
+	{
+		return;
+	}
+
+	OverfetchLevelPackage = LevelPackage;
+	OverfetchTimeLeft = Settings->OverfetchAnalysisDelay;
+	for (const FString& CollectionPath : CollectionPaths)
+	{
+		OverfetchCollectionPaths.Add(FSoftObjectPath(CollectionPath));
+	}
+#endif
+}
+
+void ULevelProgressTrackerSubsytem::CancelOverfetchAnalysis()
+{
+	if (OverfetchPostGarbageCollectHandle.IsValid())
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(OverfetchPostGarbageCollectHandle);
+		OverfetchPostGarbageCollectHandle.Reset();
+	}
+
+	if (OverfetchCollectionsHandle.IsValid())
+	{
+		OverfetchCollectionsHandle->CancelHandle();
+		OverfetchCollectionsHandle->ReleaseHandle();
+		OverfetchCollectionsHandle.Reset();
+	}
+
+	OverfetchLevelPackage = NAME_None;
+	OverfetchTimeLeft = 0.f;
+	OverfetchCollectionPaths.Reset();
+	bOverfetchGarbageCollected = false;
+}
+
+void ULevelProgressTrackerSubsytem::TickOverfetchAnalysis(float DeltaTime)
+{
+	if (OverfetchLevelPackage.IsNone())
+	{
+		return;
+	}
+
+	// Evaluated on the tick after the forced GC, outside of garbage collection callbacks.
+	if (bOverfetchGarbageCollected)
+	{
+		EvaluatePreloadOverfetch();
+		CancelOverfetchAnalysis();
+		return;
+	}
+
+	if (OverfetchCollectionsHandle.IsValid() || OverfetchPostGarbageCollectHandle.IsValid())
+	{
+		return;
+	}
+
+	OverfetchTimeLeft -= DeltaTime;
+	if (OverfetchTimeLeft > 0.f)
+	{
+		return;
+	}
+
+	// Collections hold the per-collection asset lists, they are usually released after selection.
+	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+	OverfetchCollectionsHandle = StreamableManager.RequestAsyncLoad(
+		OverfetchCollectionPaths,
+		FStreamableDelegate::CreateUObject(this, &ULevelProgressTrackerSubsytem::OnOverfetchCollectionsLoaded),
+		FStreamableManager::DefaultAsyncLoadPriority
+	);
+
+	if (!OverfetchCollectionsHandle.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (TickOverfetchAnalysis): Failed to request collections of level \"%s\". Overfetch analysis skipped."),
+			*OverfetchLevelPackage.ToString()
+		);
+
+		CancelOverfetchAnalysis();
+	}
+}
+
+void ULevelProgressTrackerSubsytem::OnOverfetchCollectionsLoaded()
+{
+	if (OverfetchLevelPackage.IsNone() || OverfetchPostGarbageCollectHandle.IsValid())
+	{
+		return;
+	}
+
+	// A speculative prefetch would keep the assets it shares with the preload set alive and hide them from the report.
+	CancelSpeculativePrefetch();
+
+	// Unreferenced preloaded assets only disappear after a full purge.
+	OverfetchPostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddWeakLambda(this, [this]()
+	{
+		bOverfetchGarbageCollected = true;
+	});
+
+	if (GEngine)
+	{
+		GEngine->ForceGarbageCollection(true);
+	}
+}
+
+void ULevelProgressTrackerSubsytem::EvaluatePreloadOverfetch()
+{
+	const FString LevelPackagePath = OverfetchLevelPackage.ToString();
+
+	TArray<TSharedPtr<FJsonValue>> CollectionValues;
+	TArray<FSoftObjectPath> UnusedAssets;
+	TSet<FSoftObjectPath> CheckedAssets;
+	int32 PreloadedAssetCount = 0;
+
+	for (const FSoftObjectPath& CollectionPath : OverfetchCollectionPaths)
+	{
+		const UAssetCollectionDataLPT* CollectionAsset = Cast<UAssetCollectionDataLPT>(CollectionPath.ResolveObject());
+		if (!CollectionAsset)
+		{
+			continue;
+		}
+
+		int32 CollectionPreloadedCount = 0;
+		int64 UnusedCostWeight = 0;
+		TArray<TSharedPtr<FJsonValue>> UnusedPathValues;
+
+		for (int32 AssetIndex = 0; AssetIndex < CollectionAsset->AssetList.Num(); ++AssetIndex)
+		{
+			const FSoftObjectPath& AssetPath = CollectionAsset->AssetList[AssetIndex];
+			if (!ResidentPreloadPaths.Contains(AssetPath))
+			{
+				continue;
+			}
+
+			++CollectionPreloadedCount;
+			if (AssetPath.ResolveObject())
+			{
+				continue;
+			}
+
+			UnusedCostWeight += CollectionAsset->GetAssetCostWeight(AssetIndex);
+			UnusedPathValues.Add(MakeShared<FJsonValueString>(AssetPath.ToString()));
+
+			bool bAlreadyChecked = false;
+			CheckedAssets.Add(AssetPath, &bAlreadyChecked);
+			if (!bAlreadyChecked)
+			{
+				UnusedAssets.Add(AssetPath);
+			}
+		}
+
+		PreloadedAssetCount += CollectionPreloadedCount;
+
+		TSharedRef<FJsonObject> CollectionObject = MakeShared<FJsonObject>();
+		CollectionObject->SetStringField(TEXT("Collection"), CollectionPath.ToString());
+		CollectionObject->SetStringField(TEXT("CollectionKey"), CollectionAsset->CollectionKey.ToString());
+		CollectionObject->SetNumberField(TEXT("PreloadedAssets"), CollectionPreloadedCount);
+		CollectionObject->SetNumberField(TEXT("UnusedAssets"), UnusedPathValues.Num());
+		CollectionObject->SetNumberField(TEXT("UnusedCostWeight"), UnusedCostWeight);
+		CollectionObject->SetArrayField(TEXT("UnusedPaths"), UnusedPathValues);
+		CollectionValues.Add(MakeShared<FJsonValueObject>(CollectionObject));
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetStringField(TEXT("Level"), LevelPackagePath);
+	RootObject->SetNumberField(TEXT("AnalysisDelay"), GetDefault<ULevelProgressTrackerSettings>()->OverfetchAnalysisDelay);
+	RootObject->SetArrayField(TEXT("Collections"), CollectionValues);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	FJsonSerializer::Serialize(RootObject, Writer);
+
+	const FString FilePath = ULevelPreloadAssetFilter::GetOverfetchReportFilePath(LevelPackagePath, FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveStringToFile(JsonText, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (EvaluatePreloadOverfetch): Failed to write '%s'."), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("LPT (EvaluatePreloadOverfetch): %d of %d preloaded assets of \"%s\" were unused. Report written to '%s'."),
+			UnusedAssets.Num(),
+			PreloadedAssetCount,
+			*LevelPackagePath,
+			*FilePath
+		);
+	}
+}
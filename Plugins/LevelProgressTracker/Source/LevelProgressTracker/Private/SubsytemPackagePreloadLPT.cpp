@@ -0,0 +1,216 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "SubsytemLPT.h"
+#include "StatsLPT.h"
+#include "TraceLPT.h"
+#include "PreloadSelectionLPT.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+void FPackagePreloadLPT::Build(const TArray<FSoftObjectPath>& Paths, const TArray<int64>& CostWeights, const TArray<ELPTAssetPriorityTier>& Tiers)
+{
+	Packages.Reset();
+	ObjectPaths.Reset();
+	CompletedPackageCount = 0;
+	LoadedObjects.Reset();
+
+	// Package names are FNames, so grouping hashes one integer per path instead of the full object path.
+	TMap<FName, int32> PackageIndices;
+	PackageIndices.Reserve(Paths.Num());
+	TArray<int32> PathPackageIndices;
+	PathPackageIndices.SetNumUninitialized(Paths.Num());
+
+	for (int32 PathIndex = 0; PathIndex < Paths.Num(); ++PathIndex)
+	{
+		const FName PackageName = Paths[PathIndex].GetLongPackageFName();
+		if (PackageName.IsNone())
+		{
+			PathPackageIndices[PathIndex] = INDEX_NONE;
+			continue;
+		}
+
+		int32 PackageIndex = INDEX_NONE;
+		if (const int32* FoundPackageIndex = PackageIndices.Find(PackageName))
+		{
+			PackageIndex = *FoundPackageIndex;
+		}
+		else
+		{
+			PackageIndex = Packages.Num();
+			PackageIndices.Add(PackageName, PackageIndex);
+			FPreloadPackageLPT& NewPackage = Packages.AddDefaulted_GetRef();
+			NewPackage.PackageName = PackageName;
+			NewPackage.Tier = ELPTAssetPriorityTier::Deferred;
+		}
+
+		FPreloadPackageLPT& Package = Packages[PackageIndex];
+		++Package.ObjectCount;
+		Package.CostWeight += CostWeights.IsValidIndex(PathIndex) ? CostWeights[PathIndex] : 0;
+
+		const ELPTAssetPriorityTier Tier = Tiers.IsValidIndex(PathIndex) ? Tiers[PathIndex] : ELPTAssetPriorityTier::Normal;
+		if (static_cast<uint8>(Tier) < static_cast<uint8>(Package.Tier))
+		{
+			Package.Tier = Tier;
+		}
+
+		PathPackageIndices[PathIndex] = PackageIndex;
+	}
+
+	int32 NextObjectIndex = 0;
+	for (FPreloadPackageLPT& Package : Packages)
+	{
+		Package.FirstObjectIndex = NextObjectIndex;
+		NextObjectIndex += Package.ObjectCount;
+	}
+
+	TArray<int32> PackageFillCounts;
+	PackageFillCounts.SetNumZeroed(Packages.Num());
+	ObjectPaths.SetNum(NextObjectIndex);
+	for (int32 PathIndex = 0; PathIndex < Paths.Num(); ++PathIndex)
+	{
+		const int32 PackageIndex = PathPackageIndices[PathIndex];
+		if (PackageIndex != INDEX_NONE)
+		{
+			ObjectPaths[Packages[PackageIndex].FirstObjectIndex + PackageFillCounts[PackageIndex]++] = Paths[PathIndex];
+		}
+	}
+}
+
+bool FPackagePreloadLPT::IsPackageResident(int32 PackageIndex) const
+{
+	const FPreloadPackageLPT& Package = Packages[PackageIndex];
+	for (int32 ObjectIndex = Package.FirstObjectIndex; ObjectIndex < Package.FirstObjectIndex + Package.ObjectCount; ++ObjectIndex)
+	{
+		if (!ObjectPaths[ObjectIndex].ResolveObject())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FPackagePreloadLPT::CompletePackage(int32 PackageIndex)
+{
+	FPreloadPackageLPT& Package = Packages[PackageIndex];
+	if (Package.bCompleted)
+	{
+		return false;
+	}
+
+	Package.bCompleted = true;
+	++CompletedPackageCount;
+
+	for (int32 ObjectIndex = Package.FirstObjectIndex; ObjectIndex < Package.FirstObjectIndex + Package.ObjectCount; ++ObjectIndex)
+	{
+		if (UObject* LoadedObject = ObjectPaths[ObjectIndex].ResolveObject())
+		{
+			LoadedObjects.Add(LoadedObject);
+		}
+	}
+
+	return true;
+}
+
+void FPackagePreloadLPT::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(LoadedObjects);
+}
+
+FString FPackagePreloadLPT::GetReferencerName() const
+{
+	return TEXT("FPackagePreloadLPT");
+}
+
+void ULevelProgressTrackerSubsytem::StartPackagePreload(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, const TArray<FSoftObjectPath>& Paths)
+{
+	LPT_TRACE_SCOPE(LPT_StartPackagePreload);
+
+	const TSharedRef<FPackagePreloadLPT> PackagePreload = MakeShared<FPackagePreloadLPT>();
+	PackagePreload->Build(Paths, LevelState->PreloadCostWeights, LevelState->PreloadTiers);
+	LevelState->PackagePreload = PackagePreload;
+
+	// Progress is tracked per package, the per-path arrays are not needed anymore.
+	LevelState->PreloadPaths.Reset();
+	LevelState->PendingCostIndices.Reset();
+
+	StatsLPT::AddAssetsRequested(Paths.Num());
+
+	if (PackagePreload->Packages.IsEmpty())
+	{
+		OnAllAssetsLoaded(PackagePath, bIsStreamingLevel, LevelState);
+		return;
+	}
+
+	const TWeakPtr<FPackagePreloadLPT> WeakPackagePreload = PackagePreload;
+	const int32 PriorityBoost = bIsStreamingLevel ? 0 : PreloadSelectionLPT::ForegroundPreloadPriorityBoost;
+
+	for (int32 PackageIndex = 0; PackageIndex < PackagePreload->Packages.Num(); ++PackageIndex)
+	{
+		// A completion below may finish, cancel or release the preload.
+		if (LevelState->PackagePreload != PackagePreload || LevelState->bCancelled || LevelState->bPreloadCompleted)
+		{
+			return;
+		}
+
+		const FPreloadPackageLPT& Package = PackagePreload->Packages[PackageIndex];
+		if (PackagePreload->IsPackageResident(PackageIndex))
+		{
+			OnPreloadPackageLoaded(Package.PackageName, nullptr, EAsyncLoadingResult::Succeeded, PackagePath, bIsStreamingLevel, LevelState, WeakPackagePreload, PackageIndex);
+			continue;
+		}
+
+		LoadPackageAsync(
+			Package.PackageName.ToString(),
+			FLoadPackageAsyncDelegate::CreateUObject(
+				this,
+				&ULevelProgressTrackerSubsytem::OnPreloadPackageLoaded,
+				PackagePath,
+				bIsStreamingLevel,
+				LevelState,
+				WeakPackagePreload,
+				PackageIndex),
+			PreloadSelectionLPT::GetTierAsyncLoadPriority(Package.Tier) + PriorityBoost
+		);
+	}
+}
+
+void ULevelProgressTrackerSubsytem::OnPreloadPackageLoaded(const FName& LoadedPackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result, FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, TWeakPtr<FPackagePreloadLPT> WeakPackagePreload, int32 PackageIndex)
+{
+	LPT_TRACE_SCOPE(LPT_OnPreloadPackageLoaded);
+	LPT_SCOPE_CALLBACK_STATS();
+
+	(void)LoadedPackage;
+
+	const TSharedPtr<FPackagePreloadLPT> PackagePreload = WeakPackagePreload.Pin();
+	if (!PackagePreload.IsValid() || LevelState->PackagePreload != PackagePreload || LevelState->bCancelled || LevelState->bPreloadCompleted)
+	{
+		return;
+	}
+
+	if (!PackagePreload->Packages.IsValidIndex(PackageIndex) || !PackagePreload->CompletePackage(PackageIndex))
+	{
+		return;
+	}
+
+	if (Result != EAsyncLoadingResult::Succeeded)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPreloadPackageLoaded): Failed to load package '%s' for level '%s'."),
+			*LoadedPackageName.ToString(),
+			*PackagePath.ToString()
+		);
+	}
+
+	const FPreloadPackageLPT& Package = PackagePreload->Packages[PackageIndex];
+	LevelState->LoadedAssets = FMath::Min(LevelState->LoadedAssets + Package.ObjectCount, LevelState->TotalAssets);
+	LevelState->LoadedCostWeight += Package.CostWeight;
+	StatsLPT::AddAssetsLoaded(Package.ObjectCount);
+
+	if (PackagePreload->CompletedPackageCount == PackagePreload->Packages.Num())
+	{
+		OnAllAssetsLoaded(PackagePath, bIsStreamingLevel, LevelState);
+		return;
+	}
+
+	BroadcastLevelLoadProgress(LevelState, LevelState->GetPreloadProgress());
+}
@@ -0,0 +1,462 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "SubsytemLPT.h"
+#include "LevelPreloadDatabaseLPT.h"
+#include "AssetCollectionDataLPT.h"
+#include "PreloadSelectionLPT.h"
+#include "SettingsLPT.h"
+#include "Dom/JsonObject.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	FString GetLearnedTransitionsFilePath()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("LPT") / TEXT("LearnedTransitionsLPT.json");
+	}
+
+	// World assets are named after their package.
+	TSoftObjectPtr<UWorld> MakeLevelSoftPtr(FName PackageName)
+	{
+		const FString PackageString = PackageName.ToString();
+
+		return TSoftObjectPtr<UWorld>(FSoftObjectPath(FString::Printf(TEXT("%s.%s"), *PackageString, *FPackageName::GetShortName(PackageString))));
+	}
+}
+
+bool ULevelProgressTrackerSubsytem::TickLPT(float DeltaTime)
+{
+	FlushPendingProgressBroadcasts();
+	UpdateRuntimeStats();
+	TickSpeculativePrefetch(DeltaTime);
+	TickMissingAssetRecording(DeltaTime);
+	TickOverfetchAnalysis(DeltaTime);
+	TickLoadWatchdog();
+
+	if (!BudgetDeferredPreloads.IsEmpty())
+	{
+		StartBudgetDeferredPreloads();
+	}
+
+	return true;
+}
+
+#pragma region PREFETCH
+void ULevelProgressTrackerSubsytem::TickSpeculativePrefetch(float DeltaTime)
+{
+	const ULevelProgressTrackerSettings* Settings = GetDefault<ULevelProgressTrackerSettings>();
+	if (!Settings->bEnableSpeculativePrefetch || !IsPreloadDatabaseReadyLPT())
+	{
+		return;
+	}
+
+	const FName CurrentPackage = GetCurrentWorldPackageName();
+	if (CurrentPackage.IsNone() || CurrentPackage == PrefetchSourcePackage)
+	{
+		return;
+	}
+
+	// Idle means no LPT transition in flight and no other async loading in the engine. A prefetch is also held back
+	// while the overfetch analysis waits for its garbage collection, it would keep preloaded assets alive.
+	if (!LevelLoadedMap.IsEmpty() || IsAsyncLoading() || OverfetchPostGarbageCollectHandle.IsValid())
+	{
+		PrefetchIdleTime = 0.f;
+		return;
+	}
+
+	PrefetchIdleTime += DeltaTime;
+	if (PrefetchIdleTime < Settings->PrefetchIdleDelay)
+	{
+		return;
+	}
+
+	// One prefetch decision per map.
+	PrefetchSourcePackage = CurrentPackage;
+	PrefetchIdleTime = 0.f;
+
+	TSoftObjectPtr<UWorld> NextLevelSoftPtr;
+	if (FindLikelyNextLevel(CurrentPackage, NextLevelSoftPtr))
+	{
+		StartSpeculativePrefetch(NextLevelSoftPtr);
+	}
+}
+
+bool ULevelProgressTrackerSubsytem::FindLikelyNextLevel(FName SourcePackage, TSoftObjectPtr<UWorld>& OutLevelSoftPtr) const
+{
+	const ULevelPreloadDatabaseLPT* PreloadDatabase = PreloadDatabaseAsset.Get();
+	if (!PreloadDatabase)
+	{
+		return false;
+	}
+
+	TMap<FName, float> Scores;
+	TMap<FName, TSoftObjectPtr<UWorld>> Candidates;
+
+	// Authored edges from the source level entry.
+	if (const FLevelPreloadEntryLPT* SourceEntry = PreloadDatabase->FindEntryByLevel(MakeLevelSoftPtr(SourcePackage)))
+	{
+		for (const FLevelTransitionLPT& Transition : SourceEntry->NextLevels)
+		{
+			const FName TargetPackage = Transition.TargetLevel.ToSoftObjectPath().GetLongPackageFName();
+			if (TargetPackage.IsNone() || Transition.Weight <= 0.f)
+			{
+				continue;
+			}
+
+			Scores.FindOrAdd(TargetPackage) += Transition.Weight;
+			Candidates.Add(TargetPackage, Transition.TargetLevel);
+		}
+	}
+
+	// Learned edges are added as observed transition frequency.
+	if (const TMap<FName, int32>* LearnedTargets = LearnedTransitions.Find(SourcePackage))
+	{
+		int32 TotalCount = 0;
+		for (const TPair<FName, int32>& LearnedTarget : *LearnedTargets)
+		{
+			TotalCount += LearnedTarget.Value;
+		}
+
+		for (const TPair<FName, int32>& LearnedTarget : *LearnedTargets)
+		{
+			if (TotalCount <= 0 || LearnedTarget.Value <= 0)
+			{
+				continue;
+			}
+
+			Scores.FindOrAdd(LearnedTarget.Key) += static_cast<float>(LearnedTarget.Value) / TotalCount;
+		}
+	}
+
+	FName BestPackage = NAME_None;
+	float BestScore = 0.f;
+	for (const TPair<FName, float>& Score : Scores)
+	{
+		if (Score.Key != SourcePackage && Score.Value > BestScore)
+		{
+			BestPackage = Score.Key;
+			BestScore = Score.Value;
+		}
+	}
+
+	if (BestPackage.IsNone())
+	{
+		return false;
+	}
+
+	if (const TSoftObjectPtr<UWorld>* AuthoredLevel = Candidates.Find(BestPackage))
+	{
+		OutLevelSoftPtr = *AuthoredLevel;
+		return true;
+	}
+
+	// Learned targets only know the package.
+	OutLevelSoftPtr = MakeLevelSoftPtr(BestPackage);
+
+	return true;
+}
+
+void ULevelProgressTrackerSubsytem::StartSpeculativePrefetch(const TSoftObjectPtr<UWorld>& LevelSoftPtr)
+{
+	CancelSpeculativePrefetch();
+
+	const ULevelPreloadDatabaseLPT* PreloadDatabase = PreloadDatabaseAsset.Get();
+	const FLevelPreloadEntryLPT* LevelEntry = PreloadDatabase ? PreloadDatabase->FindEntryByLevel(LevelSoftPtr) : nullptr;
+	if (!LevelEntry)
+	{
+		return;
+	}
+
+	const FName PackagePath = LevelSoftPtr.ToSoftObjectPath().GetLongPackageFName();
+	PrefetchState.PackagePath = PackagePath;
+	PrefetchState.LevelSoftPtr = LevelSoftPtr;
+
+	// A baked merged list of the default selection needs no collection assets.
+	if (PreloadSelectionLPT::FindSelectedMergedList(*LevelEntry, FLPTLoadOptions()))
+	{
+		OnPrefetchCollectionsLoaded(PackagePath);
+		return;
+	}
+
+	TArray<FSoftObjectPath> CollectionPaths;
+	PreloadSelectionLPT::SelectCollectionPathsForLoad(*LevelEntry, FLPTLoadOptions(), CollectionPaths);
+
+	if (CollectionPaths.IsEmpty())
+	{
+		PrefetchState = FLevelPrefetchLPT();
+		return;
+	}
+
+	// Prefetch stays below the high priority used by requested transitions.
+	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+	TSharedPtr<FStreamableHandle> MetadataHandle = StreamableManager.RequestAsyncLoad(
+		CollectionPaths,
+		FStreamableDelegate::CreateUObject(
+			this,
+			&ULevelProgressTrackerSubsytem::OnPrefetchCollectionsLoaded,
+			PackagePath),
+		FStreamableManager::DefaultAsyncLoadPriority
+	);
+
+	// The callback may have already completed the prefetch setup for resident collections.
+	if (MetadataHandle.IsValid() && PrefetchState.PackagePath == PackagePath && !PrefetchState.Handle.IsValid())
+	{
+		PrefetchState.MetadataHandle = MetadataHandle;
+	}
+	else if (MetadataHandle.IsValid())
+	{
+		MetadataHandle->ReleaseHandle();
+	}
+}
+
+void ULevelProgressTrackerSubsytem::OnPrefetchCollectionsLoaded(FName PackagePath)
+{
+	// A transition or a new map may have replaced this prefetch.
+	if (PrefetchState.PackagePath != PackagePath || PrefetchState.Handle.IsValid())
+	{
+		return;
+	}
+
+	const ULevelPreloadDatabaseLPT* PreloadDatabase = PreloadDatabaseAsset.Get();
+	const FLevelPreloadEntryLPT* LevelEntry = PreloadDatabase ? PreloadDatabase->FindEntryByLevel(PrefetchState.LevelSoftPtr) : nullptr;
+	if (!LevelEntry)
+	{
+		CancelSpeculativePrefetch();
+		return;
+	}
+
+	// An outdated record is left to the real transition, which falls back to loading every collection.
+	if (LevelEntry->RuntimeRecord.bBaked && !PreloadSelectionLPT::FindSelectedMergedList(*LevelEntry, FLPTLoadOptions()) && !PreloadSelectionLPT::IsRuntimeRecordCurrent(*LevelEntry, FLPTLoadOptions()))
+	{
+		CancelSpeculativePrefetch();
+		return;
+	}
+
+	PreloadSelectionLPT::FPreloadListLPT PreloadList;
+	PreloadSelectionLPT::BuildPreloadList(*LevelEntry, FLPTLoadOptions(), PreloadList);
+
+	TArray<FSoftObjectPath>& Paths = PreloadList.Paths;
+	const TArray<int64>& CostWeights = PreloadList.CostWeights;
+
+	if (PrefetchState.MetadataHandle.IsValid())
+	{
+		PrefetchState.MetadataHandle->ReleaseHandle();
+		PrefetchState.MetadataHandle.Reset();
+	}
+
+	// The cap is measured by generated cost weights. Lists without weights are not capped.
+	const int64 MemoryCapBytes = static_cast<int64>(GetDefault<ULevelProgressTrackerSettings>()->PrefetchMemoryCapMB) * 1024 * 1024;
+	if (MemoryCapBytes > 0 && CostWeights.Num() == Paths.Num())
+	{
+		int64 PrefetchCostWeight = 0;
+		int32 PrefetchAssetCount = 0;
+		while (PrefetchAssetCount < Paths.Num() && PrefetchCostWeight + CostWeights[PrefetchAssetCount] <= MemoryCapBytes)
+		{
+			PrefetchCostWeight += CostWeights[PrefetchAssetCount];
+			++PrefetchAssetCount;
+		}
+
+		Paths.SetNum(PrefetchAssetCount);
+		PrefetchState.CostWeight = PrefetchCostWeight;
+	}
+	else if (CostWeights.Num() == Paths.Num())
+	{
+		for (const int64 CostWeight : CostWeights)
+		{
+			PrefetchState.CostWeight += CostWeight;
+		}
+	}
+
+	if (Paths.IsEmpty())
+	{
+		PrefetchState = FLevelPrefetchLPT();
+		return;
+	}
+
+	FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+		Paths,
+		FStreamableDelegate(),
+		FStreamableManager::DefaultAsyncLoadPriority
+	);
+
+	if (!Handle.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnPrefetchCollectionsLoaded): Failed to request prefetch for level '%s'."),
+			*PackagePath.ToString()
+		);
+
+		PrefetchState = FLevelPrefetchLPT();
+		return;
+	}
+
+	PrefetchState.Handle = Handle;
+	PrefetchState.RequestTime = FPlatformTime::Seconds();
+}
+
+void ULevelProgressTrackerSubsytem::CancelSpeculativePrefetch()
+{
+	auto CancelOneHandle = [](TSharedPtr<FStreamableHandle>& HandleToCancel)
+	{
+		if (HandleToCancel.IsValid())
+		{
+			HandleToCancel->CancelHandle();
+			HandleToCancel->ReleaseHandle();
+			HandleToCancel.Reset();
+		}
+	};
+
+	CancelOneHandle(PrefetchState.MetadataHandle);
+	CancelOneHandle(PrefetchState.Handle);
+	PrefetchState = FLevelPrefetchLPT();
+}
+
+bool ULevelProgressTrackerSubsytem::AdoptSpeculativePrefetch(FName PackagePath, TSharedRef<FLevelState> LevelState)
+{
+	if (PrefetchState.PackagePath != PackagePath || !PrefetchState.Handle.IsValid())
+	{
+		return false;
+	}
+
+	// The level state keeps prefetched assets referenced until the level is opened. Requests for the same
+	// assets complete immediately or join the loads that are already in flight.
+	LevelState->ChunkHandles.Add(PrefetchState.Handle);
+	PrefetchState.Handle.Reset();
+	CancelSpeculativePrefetch();
+
+	return true;
+}
+
+#pragma endregion PREFETCH
+
+#pragma region TRANSITION_GRAPH
+void ULevelProgressTrackerSubsytem::RecordLevelTransition(FName TargetPackage)
+{
+	if (!GetDefault<ULevelProgressTrackerSettings>()->bLearnLevelTransitions)
+	{
+		return;
+	}
+
+	const FName SourcePackage = GetCurrentWorldPackageName();
+	if (SourcePackage.IsNone() || TargetPackage.IsNone() || SourcePackage == TargetPackage)
+	{
+		return;
+	}
+
+	++LearnedTransitions.FindOrAdd(SourcePackage).FindOrAdd(TargetPackage);
+	bLearnedTransitionsDirty = true;
+}
+
+void ULevelProgressTrackerSubsytem::LoadLearnedTransitions()
+{
+	LearnedTransitions.Reset();
+	bLearnedTransitionsDirty = false;
+
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *GetLearnedTransitionsFilePath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> RootObject;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (LoadLearnedTransitions): Failed to parse '%s'."), *GetLearnedTransitionsFilePath());
+		return;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* TransitionValues = nullptr;
+	if (!RootObject->TryGetArrayField(TEXT("Transitions"), TransitionValues))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& TransitionValue : *TransitionValues)
+	{
+		const TSharedPtr<FJsonObject>* TransitionObject = nullptr;
+		if (!TransitionValue.IsValid() || !TransitionValue->TryGetObject(TransitionObject))
+		{
+			continue;
+		}
+
+		FString From;
+		FString To;
+		int32 Count = 0;
+		if ((*TransitionObject)->TryGetStringField(TEXT("From"), From) &&
+			(*TransitionObject)->TryGetStringField(TEXT("To"), To) &&
+			(*TransitionObject)->TryGetNumberField(TEXT("Count"), Count) &&
+			Count > 0)
+		{
+			LearnedTransitions.FindOrAdd(FName(*From)).FindOrAdd(FName(*To)) += Count;
+		}
+	}
+}
+
+void ULevelProgressTrackerSubsytem::SaveLearnedTransitions()
+{
+	if (!bLearnedTransitionsDirty)
+	{
+		return;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> TransitionValues;
+	for (const TPair<FName, TMap<FName, int32>>& Source : LearnedTransitions)
+	{
+		for (const TPair<FName, int32>& Target : Source.Value)
+		{
+			TSharedRef<FJsonObject> TransitionObject = MakeShared<FJsonObject>();
+			TransitionObject->SetStringField(TEXT("From"), Source.Key.ToString());
+			TransitionObject->SetStringField(TEXT("To"), Target.Key.ToString());
+			TransitionObject->SetNumberField(TEXT("Count"), Target.Value);
+			TransitionValues.Add(MakeShared<FJsonValueObject>(TransitionObject));
+		}
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetArrayField(TEXT("Transitions"), TransitionValues);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	if (!FJsonSerializer::Serialize(RootObject, Writer))
+	{
+		return;
+	}
+
+	const FString FilePath = GetLearnedTransitionsFilePath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (FFileHelper::SaveStringToFile(JsonText, *FilePath))
+	{
+		bLearnedTransitionsDirty = false;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (SaveLearnedTransitions): Failed to write '%s'."), *FilePath);
+	}
+}
+
+#pragma endregion TRANSITION_GRAPH
+
+FName ULevelProgressTrackerSubsytem::GetCurrentWorldPackageName() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return NAME_None;
+	}
+
+	const FString OriginalPackageName = World->GetOutermost()->GetName();
+
+	return World->IsPlayInEditor() ? FName(*UWorld::RemovePIEPrefix(OriginalPackageName)) : FName(*OriginalPackageName);
+}
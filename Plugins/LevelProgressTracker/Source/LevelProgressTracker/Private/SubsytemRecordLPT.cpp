@@ -0,0 +1,177 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "SubsytemLPT.h"
+#include "LevelPreloadAssetFilter.h"
+#include "SettingsLPT.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	// Engine, transient and external actor packages are never preloaded by collections.
+	bool IsRecordablePackage(const FString& PackageName)
+	{
+		return !PackageName.StartsWith(TEXT("/Script/")) &&
+			!PackageName.StartsWith(TEXT("/Temp/")) &&
+			!PackageName.StartsWith(TEXT("/Engine/Transient")) &&
+			!PackageName.Contains(TEXT("/__External"));
+	}
+}
+
+void ULevelProgressTrackerSubsytem::StartMissingAssetRecording(FName LevelPackage)
+{
+#if !UE_BUILD_SHIPPING
+	StopMissingAssetRecording();
+
+	const ULevelProgressTrackerSettings* Settings = GetDefault<ULevelProgressTrackerSettings>();
+	if (!Settings->bRecordMissingAssets || LevelPackage.IsNone())
+	{
+		return;
+	}
+
+	RecordLevelPackage = LevelPackage;
+	RecordTimeLeft = Settings->RecordWindowDuration;
+
+	RecordPreloadedPackages.Reset();
+	RecordPreloadedPackages.Reserve(ResidentPreloadPaths.Num());
+	for (const FSoftObjectPath& PreloadPath : ResidentPreloadPaths)
+	{
+		RecordPreloadedPackages.Add(PreloadPath.GetLongPackageFName());
+	}
+
+	RecordEndLoadPackageHandle = FCoreUObjectDelegates::OnEndLoadPackage.AddUObject(this, &ULevelProgressTrackerSubsytem::OnRecordEndLoadPackage);
+
+	UE_LOG(LogTemp, Log, TEXT("LPT (StartMissingAssetRecording): Recording assets missing from the preload set of \"%s\" for %.1f s."),
+		*LevelPackage.ToString(),
+		RecordTimeLeft
+	);
+#endif
+}
+
+void ULevelProgressTrackerSubsytem::StopMissingAssetRecording()
+{
+	if (RecordLevelPackage.IsNone())
+	{
+		return;
+	}
+
+	FCoreUObjectDelegates::OnEndLoadPackage.Remove(RecordEndLoadPackageHandle);
+	RecordEndLoadPackageHandle.Reset();
+
+	const FString LevelPackagePath = RecordLevelPackage.ToString();
+	const FString FilePath = ULevelPreloadAssetFilter::GetLearnedAssetsFilePath(LevelPackagePath);
+	TSet<FSoftObjectPath> LearnedAssets = MoveTemp(RecordedMissingAssets);
+
+	RecordLevelPackage = NAME_None;
+	RecordTimeLeft = 0.f;
+	RecordPreloadedPackages.Reset();
+	RecordedMissingAssets.Reset();
+
+	if (LearnedAssets.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 RecordedAssetCount = LearnedAssets.Num();
+
+	// Merge with earlier sessions, so rarely visited parts of the level are not lost.
+	FString ExistingJsonText;
+	if (FFileHelper::LoadFileToString(ExistingJsonText, *FilePath))
+	{
+		TSharedPtr<FJsonObject> ExistingObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ExistingJsonText);
+		const TArray<TSharedPtr<FJsonValue>>* AssetValues = nullptr;
+		if (FJsonSerializer::Deserialize(Reader, ExistingObject) && ExistingObject.IsValid() && ExistingObject->TryGetArrayField(TEXT("Assets"), AssetValues))
+		{
+			for (const TSharedPtr<FJsonValue>& AssetValue : *AssetValues)
+			{
+				FString AssetPath;
+				if (AssetValue.IsValid() && AssetValue->TryGetString(AssetPath))
+				{
+					LearnedAssets.Add(FSoftObjectPath(AssetPath));
+				}
+			}
+		}
+	}
+
+	TArray<FString> SortedAssetPaths;
+	SortedAssetPaths.Reserve(LearnedAssets.Num());
+	for (const FSoftObjectPath& AssetPath : LearnedAssets)
+	{
+		SortedAssetPaths.Add(AssetPath.ToString());
+	}
+	SortedAssetPaths.Sort();
+
+	TArray<TSharedPtr<FJsonValue>> AssetValues;
+	AssetValues.Reserve(SortedAssetPaths.Num());
+	for (const FString& AssetPath : SortedAssetPaths)
+	{
+		AssetValues.Add(MakeShared<FJsonValueString>(AssetPath));
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetStringField(TEXT("Level"), LevelPackagePath);
+	RootObject->SetArrayField(TEXT("Assets"), AssetValues);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	FJsonSerializer::Serialize(RootObject, Writer);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveStringToFile(JsonText, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (StopMissingAssetRecording): Failed to write '%s'."), *FilePath);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("LPT (StopMissingAssetRecording): Recorded %d assets missing from the preload set of \"%s\" to '%s'."),
+		RecordedAssetCount,
+		*LevelPackagePath,
+		*FilePath
+	);
+}
+
+void ULevelProgressTrackerSubsytem::TickMissingAssetRecording(float DeltaTime)
+{
+	if (RecordLevelPackage.IsNone())
+	{
+		return;
+	}
+
+	RecordTimeLeft -= DeltaTime;
+	if (RecordTimeLeft <= 0.f)
+	{
+		StopMissingAssetRecording();
+	}
+}
+
+void ULevelProgressTrackerSubsytem::OnRecordEndLoadPackage(const FEndLoadPackageContext& Context)
+{
+	for (UPackage* LoadedPackage : Context.LoadedPackages)
+	{
+		if (!LoadedPackage || LoadedPackage->GetFName() == RecordLevelPackage || RecordPreloadedPackages.Contains(LoadedPackage->GetFName()))
+		{
+			continue;
+		}
+
+		if (!IsRecordablePackage(LoadedPackage->GetName()))
+		{
+			continue;
+		}
+
+		// Map packages, such as streaming sublevels, are loaded by the level itself.
+		const UObject* Asset = LoadedPackage->FindAssetInPackage();
+		if (Asset && !Asset->IsA<UWorld>())
+		{
+			RecordedMissingAssets.Add(FSoftObjectPath(Asset));
+		}
+	}
+}
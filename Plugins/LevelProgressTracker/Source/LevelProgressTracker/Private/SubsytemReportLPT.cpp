@@ -0,0 +1,77 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "SubsytemLPT.h"
+#include "LoadSessionReportLPT.h"
+#include "SettingsLPT.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	// Number of slowest chunks listed separately in a session report.
+	constexpr int32 MaxReportedSlowestChunks = 5;
+}
+
+void ULevelProgressTrackerSubsytem::CollectFailedPreloadPaths(TSharedRef<FLevelState> LevelState)
+{
+	// Shared assets are resident already, so every selected path is expected to resolve once the preload has completed.
+	for (const FSoftObjectPath& Path : LevelState->SelectedPreloadPaths)
+	{
+		if (!Path.IsNull() && !Path.ResolveObject())
+		{
+			LevelState->SessionReport.FailedPaths.Add(Path.ToString());
+		}
+	}
+}
+
+void ULevelProgressTrackerSubsytem::FinishLoadSessionReport(TSharedRef<FLevelState> LevelState)
+{
+	const double FinishTime = FPlatformTime::Seconds();
+
+	FLPTLoadSessionReportData& Data = LevelState->SessionReport;
+	Data.LevelName = LevelState->LevelName;
+	Data.LevelPath = LevelState->LevelSoftPtr.ToString();
+	Data.LoadHandleId = LevelState->LoadHandle.Id;
+	Data.bIsStreamingLevel = LevelState->LoadMethod == ELevelLoadMethod::LevelStreaming;
+	Data.bCancelled = LevelState->bCancelled;
+	Data.RequestedCollectionKeys = LevelState->LoadOptions.CollectionKeys;
+	Data.RequestedGroupTags = LevelState->LoadOptions.GroupTags;
+	Data.TotalAssets = LevelState->TotalAssets;
+	Data.SharedAssets = LevelState->SharedAssetCount;
+	Data.TotalCostWeight = LevelState->TotalCostWeight;
+	Data.FinalChunkSize = Data.bChunkedPreload ? LevelState->PreloadChunkSize : 0;
+	Data.TotalTime = static_cast<float>(FinishTime - LevelState->RequestTime);
+
+	if (LevelState->LevelRequestTime > 0.0)
+	{
+		Data.TimeToPreloadComplete = static_cast<float>(LevelState->LevelRequestTime - LevelState->RequestTime);
+		Data.TimeToLevelLoaded = static_cast<float>(FinishTime - LevelState->LevelRequestTime);
+	}
+
+	Data.SlowestChunks = Data.Chunks;
+	Data.SlowestChunks.Sort([](const FLPTChunkReport& A, const FLPTChunkReport& B)
+	{
+		return A.Duration > B.Duration;
+	});
+	if (Data.SlowestChunks.Num() > MaxReportedSlowestChunks)
+	{
+		Data.SlowestChunks.SetNum(MaxReportedSlowestChunks);
+	}
+
+	ULPTLoadSessionReport* Report = NewObject<ULPTLoadSessionReport>(this);
+	Report->Data = MoveTemp(Data);
+	LevelState->SessionReport = FLPTLoadSessionReportData();
+
+#if !UE_BUILD_SHIPPING
+	if (GetDefault<ULevelProgressTrackerSettings>()->bWriteLoadSessionReports)
+	{
+		Report->WriteToFileAsync();
+	}
+#endif
+
+	LastLoadSessionReport = Report;
+}
+
+ULPTLoadSessionReport* ULevelProgressTrackerSubsytem::GetLastLoadSessionReportLPT() const
+{
+	return LastLoadSessionReport;
+}
@@ -1,7 +1,10 @@
 // Pavel Gornostaev <https://github.com/Pavreally>
 
 #include "SubsytemLPT.h"
+#include "SettingsLPT.h"
+#include "ResidentBudgetLPT.h"
 #include "Engine/StreamableManager.h"
+#include "HAL/PlatformTime.h"
 
 
 void ULevelProgressTrackerSubsytem::UnloadLevelInstanceLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, FName& LevelName)
@@ -60,3 +63,90 @@ void ULevelProgressTrackerSubsytem::UnloadAllLevelInstanceLPT()
 
 	LevelLoadedMap.Empty();
 }
+
+bool ULevelProgressTrackerSubsytem::EnforceResidentMemoryBudget(TSharedRef<FLevelState> IncomingState, int64 IncomingCostWeight)
+{
+	const int64 BudgetBytes = static_cast<int64>(GetDefault<ULevelProgressTrackerSettings>()->ResidentMemoryBudgetMB) * 1024 * 1024;
+	if (BudgetBytes <= 0)
+	{
+		return true;
+	}
+
+	// Live level states are only counted. Releasing their handles would free little, a loaded level keeps its
+	// assets referenced by its actors.
+	int64 HeldCostWeight = 0;
+	bool bHasRunningPreload = false;
+	for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+	{
+		const TSharedPtr<FLevelState>& LevelState = Level.Value;
+		if (!LevelState.IsValid() || LevelState == IncomingState || !ResidentBudgetLPT::HoldsResidentAssets(*LevelState))
+		{
+			continue;
+		}
+
+		HeldCostWeight += LevelState->ResidentCostWeight;
+		bHasRunningPreload |= ResidentBudgetLPT::IsPreloadRunning(*LevelState);
+	}
+
+	// A prefetch of the incoming level is adopted by it instead.
+	const bool bHasPrefetch = PrefetchState.Handle.IsValid() && PrefetchState.PackagePath != FName(*IncomingState->LevelSoftPtr.ToSoftObjectPath().GetLongPackageName());
+	const int64 PrefetchCostWeight = bHasPrefetch ? PrefetchState.CostWeight : 0;
+
+	const ResidentBudgetLPT::FBudgetDecisionLPT Decision = ResidentBudgetLPT::DecideIncomingPreload(
+		HeldCostWeight,
+		PrefetchCostWeight,
+		bHasRunningPreload,
+		IncomingState->bPinned,
+		IncomingCostWeight,
+		BudgetBytes
+	);
+
+	if (Decision.bReleasePrefetch)
+	{
+		UE_LOG(LogTemp, Log, TEXT("LPT (EnforceResidentMemoryBudget): Releasing speculative prefetch of '%s' (%lld bytes) for the preload of level '%s'."),
+			*PrefetchState.PackagePath.ToString(),
+			PrefetchCostWeight,
+			*IncomingState->LevelName.ToString()
+		);
+
+		CancelSpeculativePrefetch();
+	}
+
+	if (Decision.bExceedsBudget)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (EnforceResidentMemoryBudget): Preload of level '%s' exceeds the resident memory budget (%lld of %lld bytes, %lld held by loaded or pinned levels)."),
+			*IncomingState->LevelName.ToString(),
+			HeldCostWeight + IncomingCostWeight,
+			BudgetBytes,
+			HeldCostWeight
+		);
+	}
+
+	return !Decision.bDeferIncoming;
+}
+
+void ULevelProgressTrackerSubsytem::StartBudgetDeferredPreloads()
+{
+	while (!BudgetDeferredPreloads.IsEmpty())
+	{
+		const TSharedPtr<FLevelState> LevelState = BudgetDeferredPreloads[0].LevelState;
+		if (!LevelState.IsValid() || LevelState->bCancelled)
+		{
+			BudgetDeferredPreloads.RemoveAt(0);
+			continue;
+		}
+
+		// The deferred state itself is not counted while it is queued.
+		if (!EnforceResidentMemoryBudget(LevelState.ToSharedRef(), LevelState->ResidentCostWeight))
+		{
+			return;
+		}
+
+		FBudgetDeferredPreloadLPT DeferredPreload = MoveTemp(BudgetDeferredPreloads[0]);
+		BudgetDeferredPreloads.RemoveAt(0);
+
+		LevelState->bBudgetDeferred = false;
+		LevelState->LastProgressTime = FPlatformTime::Seconds();
+		RequestSelectedPreload(DeferredPreload.PackagePath, DeferredPreload.bIsStreamingLevel, LevelState.ToSharedRef(), MoveTemp(DeferredPreload.Paths));
+	}
+}
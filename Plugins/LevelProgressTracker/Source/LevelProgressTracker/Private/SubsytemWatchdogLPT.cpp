@@ -0,0 +1,220 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "SubsytemLPT.h"
+#include "SettingsLPT.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	// Pending paths listed in one stall warning.
+	constexpr int32 MaxLoggedPendingPaths = 16;
+
+	// True while the level state is preloading assets and has not requested its level yet. Preloads deferred by the
+	// resident memory budget are not active.
+	bool IsPreloadActive(const TSharedPtr<FLevelState>& LevelState)
+	{
+		return LevelState.IsValid() && !LevelState->bPreloadCompleted && !LevelState->bCancelled && !LevelState->bLevelRequested && !LevelState->bBudgetDeferred;
+	}
+}
+
+void ULevelProgressTrackerSubsytem::TickLoadWatchdog()
+{
+	if (LevelLoadedMap.IsEmpty())
+	{
+		return;
+	}
+
+	const ULevelProgressTrackerSettings* Settings = GetDefault<ULevelProgressTrackerSettings>();
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<TPair<FName, TSharedRef<FLevelState>>> TimedOutStates;
+	for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+	{
+		const TSharedPtr<FLevelState>& LevelState = Level.Value;
+		if (!LevelState.IsValid() || LevelState->bCancelled)
+		{
+			continue;
+		}
+
+		if (IsPreloadActive(LevelState))
+		{
+			const double StallTime = Now - LevelState->LastProgressTime;
+			if (Settings->PreloadStallThreshold > 0.f && !LevelState->bStallReported && StallTime > Settings->PreloadStallThreshold)
+			{
+				LevelState->bStallReported = true;
+				++LevelState->SessionReport.PreloadStalls;
+				ReportPreloadStall(LevelState.ToSharedRef(), StallTime);
+			}
+			continue;
+		}
+
+		// Loaded level instances stay in the map until they are unloaded.
+		const bool bLevelLoaded = LevelState->LoadMethod == ELevelLoadMethod::LevelStreaming && LevelState->LevelInstanceState.IsLoaded;
+		if (LevelState->bLevelRequested && !bLevelLoaded && Settings->LevelOpenTimeout > 0.f && Now - LevelState->LevelRequestTime > Settings->LevelOpenTimeout)
+		{
+			TimedOutStates.Emplace(Level.Key, LevelState.ToSharedRef());
+		}
+	}
+
+	for (const TPair<FName, TSharedRef<FLevelState>>& TimedOut : TimedOutStates)
+	{
+		AbandonLevelState(TimedOut.Key, TimedOut.Value, FString::Printf(TEXT("Level was not loaded within %.0f s of the request."), Settings->LevelOpenTimeout));
+	}
+}
+
+void ULevelProgressTrackerSubsytem::ReportPreloadStall(const TSharedRef<FLevelState>& LevelState, double StallTime)
+{
+	TArray<FSoftObjectPath> RequestedPaths;
+
+	// Progress advances in request order, so the oldest incomplete chunk is the one holding it back.
+	if (const FLevelPreloadChunkLPT* Chunk = LevelState->InFlightChunks.FindByPredicate([](const FLevelPreloadChunkLPT& InFlightChunk)
+		{
+			return !InFlightChunk.bCompleted;
+		}))
+	{
+		for (int32 PathIndex = Chunk->StartIndex; PathIndex < Chunk->StartIndex + Chunk->AssetCount && LevelState->PreloadPaths.IsValidIndex(PathIndex); ++PathIndex)
+		{
+			RequestedPaths.Add(LevelState->PreloadPaths[PathIndex]);
+		}
+	}
+	else if (LevelState->PackagePreload.IsValid())
+	{
+		for (const FPreloadPackageLPT& Package : LevelState->PackagePreload->Packages)
+		{
+			if (!Package.bCompleted)
+			{
+				RequestedPaths.Append(&LevelState->PackagePreload->ObjectPaths[Package.FirstObjectIndex], Package.ObjectCount);
+			}
+		}
+	}
+	else if (!LevelState->bUseChunkedPreload && LevelState->Handle.IsValid())
+	{
+		LevelState->Handle->GetRequestedAssets(RequestedPaths);
+	}
+
+	TArray<FString> PendingPaths;
+	for (const FSoftObjectPath& RequestedPath : RequestedPaths)
+	{
+		if (!RequestedPath.ResolveObject())
+		{
+			PendingPaths.Add(RequestedPath.ToString());
+		}
+	}
+
+	if (PendingPaths.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (ReportPreloadStall): Preload of level \"%s\" made no progress for %.1f s. No asset request is pending, the preload is waiting for the database or collection assets."),
+			*LevelState->LevelName.ToString(),
+			StallTime
+		);
+		return;
+	}
+
+	const int32 PendingPathCount = PendingPaths.Num();
+	if (PendingPaths.Num() > MaxLoggedPendingPaths)
+	{
+		PendingPaths.SetNum(MaxLoggedPendingPaths);
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("LPT (ReportPreloadStall): Preload of level \"%s\" made no progress for %.1f s. %d assets are still pending: %s%s"),
+		*LevelState->LevelName.ToString(),
+		StallTime,
+		PendingPathCount,
+		*FString::Join(PendingPaths, TEXT(", ")),
+		PendingPathCount > MaxLoggedPendingPaths ? TEXT(", ...") : TEXT("")
+	);
+}
+
+void ULevelProgressTrackerSubsytem::AbandonLevelState(FName PackagePath, TSharedRef<FLevelState> LevelState, const FString& Reason)
+{
+	UE_LOG(LogTemp, Warning, TEXT("LPT (AbandonLevelState): Level \"%s\" was released. %s"), *LevelState->LevelName.ToString(), *Reason);
+
+	if (LevelState->LevelInstanceState.LevelReference)
+	{
+		LevelState->LevelInstanceState.LevelReference->OnLevelShown.RemoveDynamic(this, &ULevelProgressTrackerSubsytem::OnLevelShown);
+	}
+
+	LevelState->bPreloadCompleted = true;
+	LevelState->bScheduled = false;
+	LevelState->SessionReport.FailureReason = Reason;
+
+	PendingDatabaseLevels.Remove(PackagePath);
+	ReleaseLevelStateHandles(LevelState, false);
+	LevelLoadedMap.Remove(PackagePath);
+	FinishLoadSessionReport(LevelState);
+
+	// Sent after the state is removed, so listeners can request the level again.
+	OnLevelLoadFailedNativeLPT.Broadcast(LevelState->LoadHandle, Reason);
+	OnLevelLoadFailedLPT.Broadcast(LevelState->LoadHandle, LevelState->LevelSoftPtr, LevelState->LevelName, Reason);
+}
+
+void ULevelProgressTrackerSubsytem::OnTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
+{
+	if (World && World != GetWorld())
+	{
+		return;
+	}
+
+	// OpenLevelLPT levels whose open was requested never receive OnPostLoadMapWithWorld after a failed travel.
+	TArray<TPair<FName, TSharedRef<FLevelState>>> FailedStates;
+	for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+	{
+		if (Level.Value.IsValid() && Level.Value->bLevelRequested && Level.Value->LoadMethod != ELevelLoadMethod::LevelStreaming)
+		{
+			FailedStates.Emplace(Level.Key, Level.Value.ToSharedRef());
+		}
+	}
+
+	for (const TPair<FName, TSharedRef<FLevelState>>& Failed : FailedStates)
+	{
+		AbandonLevelState(Failed.Key, Failed.Value, FString::Printf(TEXT("Travel failed (%s): %s"), ETravelFailure::ToString(FailureType), *ErrorString));
+	}
+}
+
+void ULevelProgressTrackerSubsytem::OnSyncLoadPackage(const FString& PackageName)
+{
+	if (!IsInGameThread())
+	{
+		return;
+	}
+
+	bool bPreloadActive = false;
+	for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+	{
+		if (IsPreloadActive(Level.Value))
+		{
+			Level.Value->SessionReport.SyncLoadsDuringPreload.Add(PackageName);
+			bPreloadActive = true;
+		}
+	}
+
+	if (bPreloadActive)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnSyncLoadPackage): Synchronous load of '%s' during an active preload. It blocks the game thread and delays the preload."), *PackageName);
+	}
+}
+
+void ULevelProgressTrackerSubsytem::OnAsyncLoadingFlush()
+{
+	if (!IsInGameThread())
+	{
+		return;
+	}
+
+	bool bPreloadActive = false;
+	for (const TPair<FName, TSharedPtr<FLevelState>>& Level : LevelLoadedMap)
+	{
+		if (IsPreloadActive(Level.Value))
+		{
+			++Level.Value->SessionReport.FlushesDuringPreload;
+			bPreloadActive = true;
+		}
+	}
+
+	if (bPreloadActive)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LPT (OnAsyncLoadingFlush): Async loading was flushed during an active preload. The game thread waits for every outstanding request, including the preload."));
+	}
+}
@@ -0,0 +1,597 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+/**
+ * LPT.Benchmark automation test. Loads the given levels with OpenLevelLPT and LoadLevelInstanceLPT in chunked,
+ * aggregated and package preload mode, and compares wall time, peak used physical memory and progress callback counts
+ * with the checked-in baseline. Every run starts cold: the previous level is unloaded by travelling back to the start map,
+ * garbage is collected, and shared asset carry-over and speculative prefetch are disabled for the duration of the test.
+ * Without -LPTBenchmarkLevels the levels under /LevelProgressTracker/Benchmark/Maps are used. They are created in the
+ * editor with the LPT.GenerateBenchmarkContent console command.
+ * Runs headless, e.g.:
+ * UnrealEditor-Cmd <Project> /Game/Maps/Entry -game -nullrhi -unattended
+ *     -ExecCmds="Automation RunTests LPT.Benchmark" -TestExit="Automation Test Queue Empty"
+ * Optional: -LPTBenchmarkLevels=/Game/Maps/A+/Game/Maps/B, -LPTBenchmarkBaseline=<File>, -LPTBenchmarkTolerance=0.2,
+ * -LPTBenchmarkUpdateBaseline. A missing baseline fails the test unless -LPTBenchmarkUpdateBaseline writes it.
+ */
+
+#include "SubsytemLPT.h"
+#include "SettingsLPT.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BenchmarkLPT
+{
+	// Values of LPT.ForcePreloadMode used by benchmark runs.
+	constexpr int32 ChunkedPreloadMode = 1;
+	constexpr int32 AggregatedPreloadMode = 2;
+	constexpr int32 PackagePreloadMode = 3;
+
+	// A run that has not finished within this time is recorded as failed.
+	constexpr double RunTimeout = 300.0;
+
+	// Frames between garbage collection and the next run, so deferred unloads and destruction finish first.
+	constexpr int32 SettleFrames = 2;
+
+	// One level load of the benchmark.
+	struct FBenchmarkRun
+	{
+		FString LevelPath;
+		bool bLevelInstance = false;
+		int32 PreloadMode = ChunkedPreloadMode;
+
+		bool bCompleted = false;
+		double WallTime = 0.0;
+		double PeakUsedPhysicalMB = 0.0;
+		double ProcessPeakUsedPhysicalMB = 0.0;
+		int32 ProgressCallbacks = 0;
+
+		FString GetKey() const
+		{
+			return FString::Printf(TEXT("%s|%s|%s"),
+				*LevelPath,
+				bLevelInstance ? TEXT("LevelInstance") : TEXT("OpenLevel"),
+				PreloadMode == ChunkedPreloadMode ? TEXT("Chunked") : PreloadMode == AggregatedPreloadMode ? TEXT("Aggregated") : TEXT("Package")
+			);
+		}
+	};
+
+	FString GetBenchmarkDirectory()
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("LPT"), TEXT("Benchmark"));
+	}
+
+	// Plugin folder with the generated benchmark levels.
+	const TCHAR* BenchmarkLevelFolder = TEXT("/LevelProgressTracker/Benchmark/Maps");
+
+	// Checked-in baseline of the current platform, unless -LPTBenchmarkBaseline= names another file.
+	FString GetBaselineFilePath()
+	{
+		FString BaselineFilePath;
+		if (FParse::Value(FCommandLine::Get(), TEXT("-LPTBenchmarkBaseline="), BaselineFilePath))
+		{
+			return FPaths::ConvertRelativePathToFull(BaselineFilePath);
+		}
+
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("LevelProgressTracker"));
+		const FString BaseDirectory = Plugin.IsValid() ? Plugin->GetBaseDir() : FPaths::ProjectDir();
+		return FPaths::ConvertRelativePathToFull(FPaths::Combine(BaseDirectory, TEXT("Benchmark"), FString::Printf(TEXT("Baseline_%s.json"), FPlatformProperties::IniPlatformName())));
+	}
+
+	// Levels given with -LPTBenchmarkLevels, otherwise the generated benchmark levels of the plugin.
+	TArray<FString> GetBenchmarkLevelPaths()
+	{
+		TArray<FString> LevelPaths;
+
+		FString LevelList;
+		if (FParse::Value(FCommandLine::Get(), TEXT("-LPTBenchmarkLevels="), LevelList, false))
+		{
+			LevelList.ParseIntoArray(LevelPaths, TEXT("+"));
+			return LevelPaths;
+		}
+
+		TArray<FAssetData> LevelAssets;
+		IAssetRegistry::GetChecked().GetAssetsByPath(FName(BenchmarkLevelFolder), LevelAssets, true);
+		for (const FAssetData& LevelAsset : LevelAssets)
+		{
+			if (LevelAsset.AssetClassPath == UWorld::StaticClass()->GetClassPathName())
+			{
+				LevelPaths.Add(LevelAsset.PackageName.ToString());
+			}
+		}
+
+		LevelPaths.Sort();
+		return LevelPaths;
+	}
+
+	double ToMB(uint64 Bytes)
+	{
+		return static_cast<double>(Bytes) / (1024.0 * 1024.0);
+	}
+
+	UWorld* FindGameWorld()
+	{
+		if (!GEngine)
+		{
+			return nullptr;
+		}
+
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			if ((WorldContext.WorldType == EWorldType::Game || WorldContext.WorldType == EWorldType::PIE) && WorldContext.World())
+			{
+				return WorldContext.World();
+			}
+		}
+
+		return nullptr;
+	}
+
+	class FBenchmark : public TSharedFromThis<FBenchmark>
+	{
+	public:
+		FBenchmark(FAutomationTestBase& InTest, ULevelProgressTrackerSubsytem* InSubsystem, const TArray<FString>& LevelPaths, const FString& InResetMapPath, float InTolerance, bool bInUpdateBaseline)
+			: Test(InTest)
+			, Subsystem(InSubsystem)
+			, ResetMapPath(InResetMapPath)
+			, Tolerance(InTolerance)
+			, bUpdateBaseline(bInUpdateBaseline)
+		{
+			for (const FString& LevelPath : LevelPaths)
+			{
+				for (const bool bLevelInstance : { false, true })
+				{
+					for (const int32 PreloadMode : { ChunkedPreloadMode, AggregatedPreloadMode, PackagePreloadMode })
+					{
+						FBenchmarkRun& Run = Runs.AddDefaulted_GetRef();
+						Run.LevelPath = LevelPath;
+						Run.bLevelInstance = bLevelInstance;
+						Run.PreloadMode = PreloadMode;
+					}
+				}
+			}
+		}
+
+		void Start()
+		{
+			Subsystem->OnLevelLoadProgressNativeLPT.AddSP(this, &FBenchmark::OnLevelLoadProgress);
+			Subsystem->OnLevelLoadedNativeLPT.AddSP(this, &FBenchmark::OnLevelLoaded);
+			PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddSP(this, &FBenchmark::OnPostLoadMap);
+
+			if (IConsoleVariable* ForcePreloadMode = IConsoleManager::Get().FindConsoleVariable(TEXT("LPT.ForcePreloadMode")))
+			{
+				PreviousPreloadMode = ForcePreloadMode->GetInt();
+			}
+
+			// Runs must not reuse assets of the previous run or of a prefetch, or later runs would preload almost nothing.
+			ULevelProgressTrackerSettings* Settings = GetMutableDefault<ULevelProgressTrackerSettings>();
+			bPreviousKeepSharedAssets = Settings->bKeepSharedAssetsBetweenLevels;
+			bPreviousSpeculativePrefetch = Settings->bEnableSpeculativePrefetch;
+			Settings->bKeepSharedAssetsBetweenLevels = false;
+			Settings->bEnableSpeculativePrefetch = false;
+
+			UE_LOG(LogTemp, Log, TEXT("LPT (Benchmark): Starting %d runs. Levels are reset to '%s' between runs."), Runs.Num(), *ResetMapPath);
+			Step = EStep::Reset;
+		}
+
+		// Returns false once the benchmark has finished.
+		bool Tick()
+		{
+			if (!Subsystem.IsValid())
+			{
+				Test.AddError(TEXT("LPT subsystem was destroyed. Benchmark aborted."));
+				return false;
+			}
+
+			switch (Step)
+			{
+			case EStep::Reset:
+				ResetBeforeRun();
+				break;
+
+			case EStep::WaitForReset:
+				if (bResetMapLoaded)
+				{
+					CollectPreviousRun();
+				}
+				break;
+
+			case EStep::Settle:
+				if (--RemainingSettleFrames <= 0 && !StartRun())
+				{
+					Finish();
+					return false;
+				}
+				break;
+
+			case EStep::Running:
+				SampleMemory();
+				if (FPlatformTime::Seconds() - RunStartTime > RunTimeout)
+				{
+					Test.AddError(FString::Printf(TEXT("Run '%s' timed out."), *Runs[RunIndex].GetKey()));
+					FinishRun(false);
+				}
+				break;
+			}
+
+			return true;
+		}
+
+		void Stop()
+		{
+			if (Subsystem.IsValid())
+			{
+				Subsystem->OnLevelLoadProgressNativeLPT.RemoveAll(this);
+				Subsystem->OnLevelLoadedNativeLPT.RemoveAll(this);
+			}
+
+			FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+			SetPreloadMode(PreviousPreloadMode);
+
+			ULevelProgressTrackerSettings* Settings = GetMutableDefault<ULevelProgressTrackerSettings>();
+			Settings->bKeepSharedAssetsBetweenLevels = bPreviousKeepSharedAssets;
+			Settings->bEnableSpeculativePrefetch = bPreviousSpeculativePrefetch;
+		}
+
+	private:
+		enum class EStep : uint8
+		{
+			Reset,
+			WaitForReset,
+			Settle,
+			Running
+		};
+
+		// Unloads the previous run's level. An opened level is left by travelling back to the reset map.
+		void ResetBeforeRun()
+		{
+			if (bTravelledAway)
+			{
+				bTravelledAway = false;
+				bResetMapLoaded = false;
+				Step = EStep::WaitForReset;
+				UGameplayStatics::OpenLevel(FindGameWorld(), FName(*ResetMapPath));
+				return;
+			}
+
+			CollectPreviousRun();
+		}
+
+		void CollectPreviousRun()
+		{
+			if (UWorld* World = FindGameWorld())
+			{
+				World->FlushLevelStreaming();
+			}
+
+			FlushAsyncLoading();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+			RemainingSettleFrames = SettleFrames;
+			Step = EStep::Settle;
+		}
+
+		// Starts the run at RunIndex. Returns false when all runs are done.
+		bool StartRun()
+		{
+			while (Runs.IsValidIndex(RunIndex))
+			{
+				FBenchmarkRun& Run = Runs[RunIndex];
+				SetPreloadMode(Run.PreloadMode);
+
+				const TSoftObjectPtr<UWorld> LevelSoftPtr{ FSoftObjectPath(Run.LevelPath) };
+				RunStartTime = FPlatformTime::Seconds();
+				Run.PeakUsedPhysicalMB = ToMB(FPlatformMemory::GetStats().UsedPhysical);
+				CurrentHandle = Run.bLevelInstance
+					? Subsystem->LoadLevelInstanceLPT(LevelSoftPtr, FTransform::Identity)
+					: Subsystem->OpenLevelLPT(LevelSoftPtr);
+
+				if (CurrentHandle.IsValid())
+				{
+					bTravelledAway = !Run.bLevelInstance;
+					Step = EStep::Running;
+					return true;
+				}
+
+				Test.AddError(FString::Printf(TEXT("Run '%s' could not be started."), *Run.GetKey()));
+				++RunIndex;
+			}
+
+			return false;
+		}
+
+		void FinishRun(bool bCompleted)
+		{
+			SampleMemory();
+
+			FBenchmarkRun& Run = Runs[RunIndex];
+			Run.bCompleted = bCompleted;
+			Run.WallTime = FPlatformTime::Seconds() - RunStartTime;
+			Run.ProcessPeakUsedPhysicalMB = ToMB(FPlatformMemory::GetStats().PeakUsedPhysical);
+
+			UE_LOG(LogTemp, Log, TEXT("LPT (Benchmark): '%s' %s in %.3f s, peak used memory %.1f MB, %d progress callbacks."),
+				*Run.GetKey(),
+				bCompleted ? TEXT("completed") : TEXT("failed"),
+				Run.WallTime,
+				Run.PeakUsedPhysicalMB,
+				Run.ProgressCallbacks
+			);
+
+			if (Run.bLevelInstance)
+			{
+				FName LevelName;
+				Subsystem->UnloadLevelInstanceLPT(TSoftObjectPtr<UWorld>(FSoftObjectPath(Run.LevelPath)), LevelName);
+			}
+
+			CurrentHandle = FLPTLoadHandle();
+			++RunIndex;
+
+			// The next run is prepared from the benchmark tick, outside of subsystem callbacks.
+			Step = EStep::Reset;
+		}
+
+		// Used memory is sampled every frame of a run. The process peak cannot be reset between runs.
+		void SampleMemory()
+		{
+			if (Runs.IsValidIndex(RunIndex))
+			{
+				FBenchmarkRun& Run = Runs[RunIndex];
+				Run.PeakUsedPhysicalMB = FMath::Max(Run.PeakUsedPhysicalMB, ToMB(FPlatformMemory::GetStats().UsedPhysical));
+			}
+		}
+
+		void OnLevelLoadProgress(FLPTLoadHandle Handle, const FLPTLoadProgress& LoadProgress)
+		{
+			if (Step == EStep::Running && Handle == CurrentHandle)
+			{
+				++Runs[RunIndex].ProgressCallbacks;
+				SampleMemory();
+			}
+		}
+
+		void OnLevelLoaded(FLPTLoadHandle Handle)
+		{
+			if (Step == EStep::Running && Handle == CurrentHandle)
+			{
+				FinishRun(true);
+			}
+		}
+
+		void OnPostLoadMap(UWorld* LoadedWorld)
+		{
+			if (Step == EStep::WaitForReset)
+			{
+				bResetMapLoaded = true;
+			}
+		}
+
+		void SetPreloadMode(int32 PreloadMode) const
+		{
+			if (IConsoleVariable* ForcePreloadMode = IConsoleManager::Get().FindConsoleVariable(TEXT("LPT.ForcePreloadMode")))
+			{
+				ForcePreloadMode->Set(PreloadMode, ECVF_SetByCode);
+			}
+		}
+
+		// Compares runs with the baseline and writes results. Regressions are reported as test errors.
+		void Finish()
+		{
+			const FString BaselineFilePath = GetBaselineFilePath();
+			TMap<FString, TSharedPtr<FJsonObject>> BaselineRuns;
+			const bool bHasBaseline = LoadRuns(BaselineFilePath, BaselineRuns);
+			if (!bHasBaseline && !bUpdateBaseline)
+			{
+				Test.AddError(FString::Printf(TEXT("No benchmark baseline at '%s'. Pass -LPTBenchmarkUpdateBaseline to write it, or -LPTBenchmarkBaseline= to use another file."), *BaselineFilePath));
+			}
+
+			for (const FBenchmarkRun& Run : Runs)
+			{
+				if (!Run.bCompleted || !bHasBaseline)
+				{
+					continue;
+				}
+
+				const TSharedPtr<FJsonObject> BaselineRun = BaselineRuns.FindRef(Run.GetKey());
+				if (!BaselineRun.IsValid())
+				{
+					if (!bUpdateBaseline)
+					{
+						Test.AddError(FString::Printf(TEXT("'%s' has no baseline in '%s'. Pass -LPTBenchmarkUpdateBaseline to add it."), *Run.GetKey(), *BaselineFilePath));
+					}
+					continue;
+				}
+
+				CheckRegression(Run, TEXT("WallTime"), Run.WallTime, BaselineRun->GetNumberField(TEXT("WallTime")));
+				CheckRegression(Run, TEXT("PeakUsedPhysicalMB"), Run.PeakUsedPhysicalMB, BaselineRun->GetNumberField(TEXT("PeakUsedPhysicalMB")));
+				CheckRegression(Run, TEXT("ProgressCallbacks"), Run.ProgressCallbacks, BaselineRun->GetNumberField(TEXT("ProgressCallbacks")));
+			}
+
+			const FString ResultsFilePath = FPaths::Combine(GetBenchmarkDirectory(), FString::Printf(TEXT("Results_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+			SaveRuns(ResultsFilePath);
+			Test.AddInfo(FString::Printf(TEXT("Results written to '%s'."), *ResultsFilePath));
+
+			if (bUpdateBaseline)
+			{
+				SaveRuns(BaselineFilePath);
+				Test.AddInfo(FString::Printf(TEXT("Baseline written to '%s'."), *BaselineFilePath));
+			}
+		}
+
+		void CheckRegression(const FBenchmarkRun& Run, const TCHAR* MetricName, double Value, double BaselineValue)
+		{
+			if (BaselineValue <= 0.0 || Value <= BaselineValue * (1.0 + Tolerance))
+			{
+				return;
+			}
+
+			Test.AddError(FString::Printf(TEXT("'%s' regressed %s: %.3f, baseline %.3f."),
+				*Run.GetKey(),
+				MetricName,
+				Value,
+				BaselineValue
+			));
+		}
+
+		static bool LoadRuns(const FString& FilePath, TMap<FString, TSharedPtr<FJsonObject>>& OutRuns)
+		{
+			FString JsonText;
+			if (!FFileHelper::LoadFileToString(JsonText, *FilePath))
+			{
+				return false;
+			}
+
+			TSharedPtr<FJsonObject> RootObject;
+			const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+			const TArray<TSharedPtr<FJsonValue>>* RunValues = nullptr;
+			if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid() || !RootObject->TryGetArrayField(TEXT("Runs"), RunValues))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("LPT (Benchmark): Failed to parse '%s'."), *FilePath);
+				return false;
+			}
+
+			for (const TSharedPtr<FJsonValue>& RunValue : *RunValues)
+			{
+				const TSharedPtr<FJsonObject>* RunObject = nullptr;
+				FString Key;
+				if (RunValue.IsValid() && RunValue->TryGetObject(RunObject) && (*RunObject)->TryGetStringField(TEXT("Key"), Key))
+				{
+					OutRuns.Add(Key, *RunObject);
+				}
+			}
+
+			return true;
+		}
+
+		void SaveRuns(const FString& FilePath) const
+		{
+			TArray<TSharedPtr<FJsonValue>> RunValues;
+			for (const FBenchmarkRun& Run : Runs)
+			{
+				TSharedRef<FJsonObject> RunObject = MakeShared<FJsonObject>();
+				RunObject->SetStringField(TEXT("Key"), Run.GetKey());
+				RunObject->SetBoolField(TEXT("Completed"), Run.bCompleted);
+				RunObject->SetNumberField(TEXT("WallTime"), Run.WallTime);
+				RunObject->SetNumberField(TEXT("PeakUsedPhysicalMB"), Run.PeakUsedPhysicalMB);
+				RunObject->SetNumberField(TEXT("ProcessPeakUsedPhysicalMB"), Run.ProcessPeakUsedPhysicalMB);
+				RunObject->SetNumberField(TEXT("ProgressCallbacks"), Run.ProgressCallbacks);
+				RunValues.Add(MakeShared<FJsonValueObject>(RunObject));
+			}
+
+			TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+			RootObject->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+			RootObject->SetArrayField(TEXT("Runs"), RunValues);
+
+			FString JsonText;
+			const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+			FJsonSerializer::Serialize(RootObject, Writer);
+
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+			if (!FFileHelper::SaveStringToFile(JsonText, *FilePath))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("LPT (Benchmark): Failed to write '%s'."), *FilePath);
+			}
+		}
+
+		FAutomationTestBase& Test;
+		TWeakObjectPtr<ULevelProgressTrackerSubsytem> Subsystem;
+		FString ResetMapPath;
+		TArray<FBenchmarkRun> Runs;
+		int32 RunIndex = 0;
+		FLPTLoadHandle CurrentHandle;
+		double RunStartTime = 0.0;
+
+		EStep Step = EStep::Reset;
+		int32 RemainingSettleFrames = 0;
+		bool bTravelledAway = false;
+		bool bResetMapLoaded = false;
+		FDelegateHandle PostLoadMapHandle;
+
+		int32 PreviousPreloadMode = 0;
+		bool bPreviousKeepSharedAssets = true;
+		bool bPreviousSpeculativePrefetch = false;
+
+		float Tolerance = 0.2f;
+		bool bUpdateBaseline = false;
+	};
+
+	// Ticks the benchmark once per frame until all runs are done.
+	class FBenchmarkLatentCommand : public IAutomationLatentCommand
+	{
+	public:
+		explicit FBenchmarkLatentCommand(const TSharedRef<FBenchmark>& InBenchmark)
+			: Benchmark(InBenchmark)
+		{
+		}
+
+		virtual bool Update() override
+		{
+			if (Benchmark->Tick())
+			{
+				return false;
+			}
+
+			Benchmark->Stop();
+			return true;
+		}
+
+	private:
+		TSharedRef<FBenchmark> Benchmark;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBenchmarkTestLPT, "LPT.Benchmark",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FBenchmarkTestLPT::RunTest(const FString& Parameters)
+{
+	const TArray<FString> LevelPaths = BenchmarkLPT::GetBenchmarkLevelPaths();
+	if (LevelPaths.IsEmpty())
+	{
+		AddError(FString::Printf(TEXT("No benchmark levels found in '%s'. Run LPT.GenerateBenchmarkContent in the editor, or pass -LPTBenchmarkLevels=/Game/Maps/A+/Game/Maps/B."), BenchmarkLPT::BenchmarkLevelFolder));
+		return false;
+	}
+
+	UWorld* World = BenchmarkLPT::FindGameWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	ULevelProgressTrackerSubsytem* Subsystem = GameInstance ? GameInstance->GetSubsystem<ULevelProgressTrackerSubsytem>() : nullptr;
+	if (!Subsystem)
+	{
+		AddError(TEXT("LPT subsystem is not available. Run the benchmark in a game world, e.g. with -game."));
+		return false;
+	}
+
+	float Tolerance = 0.2f;
+	FParse::Value(FCommandLine::Get(), TEXT("-LPTBenchmarkTolerance="), Tolerance);
+	const bool bUpdateBaseline = FParse::Param(FCommandLine::Get(), TEXT("LPTBenchmarkUpdateBaseline"));
+
+	// Opened levels are left by travelling back to the map the test started in.
+	const FString ResetMapPath = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+
+	const TSharedRef<BenchmarkLPT::FBenchmark> Benchmark = MakeShared<BenchmarkLPT::FBenchmark>(*this, Subsystem, LevelPaths, ResetMapPath, FMath::Max(0.f, Tolerance), bUpdateBaseline);
+	Benchmark->Start();
+	ADD_LATENT_AUTOMATION_COMMAND(BenchmarkLPT::FBenchmarkLatentCommand(Benchmark));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,102 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "Misc/AutomationTest.h"
+#include "AssetCollectionDataLPT.h"
+#include "LevelPreloadDatabaseLPT.h"
+#include "PreloadSelectionLPT.h"
+#include "SubsytemLPT.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	UAssetCollectionDataLPT* MakeCollection(const TArray<FString>& AssetPaths, uint32 CollectionContentHash)
+	{
+		UAssetCollectionDataLPT* CollectionAsset = NewObject<UAssetCollectionDataLPT>(GetTransientPackage());
+		CollectionAsset->CollectionKey = PreloadSelectionLPT::DefaultCollectionKey;
+		CollectionAsset->CollectionContentHash = CollectionContentHash;
+		for (const FString& AssetPath : AssetPaths)
+		{
+			CollectionAsset->AssetList.Add(FSoftObjectPath(AssetPath));
+		}
+		return CollectionAsset;
+	}
+
+	// Record as the cook bake writes it for the collection in its current state.
+	void AddCollectionRecord(FLevelPreloadEntryLPT& Entry, UAssetCollectionDataLPT* CollectionAsset)
+	{
+		Entry.Collections.Add(CollectionAsset);
+
+		FLevelCollectionRecordLPT& CollectionRecord = Entry.RuntimeRecord.Collections.AddDefaulted_GetRef();
+		CollectionRecord.Collection = CollectionAsset;
+		CollectionRecord.CollectionKey = CollectionAsset->CollectionKey;
+		CollectionRecord.GroupTags = CollectionAsset->GroupTags;
+		CollectionRecord.AssetCount = CollectionAsset->AssetList.Num();
+		CollectionRecord.CollectionContentHash = CollectionAsset->CollectionContentHash;
+		Entry.RuntimeRecord.bBaked = true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPreloadSelectionRuntimeRecordTestLPT, "LPT.PreloadSelection.RuntimeRecord",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPreloadSelectionRuntimeRecordTestLPT::RunTest(const FString& Parameters)
+{
+	UAssetCollectionDataLPT* CollectionAsset = MakeCollection({ TEXT("/Game/A.A"), TEXT("/Game/B.B") }, 1);
+
+	FLevelPreloadEntryLPT Entry;
+	AddCollectionRecord(Entry, CollectionAsset);
+	TestTrue(TEXT("Record baked from the current collection is current"), PreloadSelectionLPT::IsRuntimeRecordCurrent(Entry, FLPTLoadOptions()));
+
+	// Collection cooked again after the database, e.g. regenerated without a database cook.
+	CollectionAsset->CollectionContentHash = 2;
+	AddExpectedError(TEXT("changed after the preload database was cooked"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Record with another content hash is rejected"), PreloadSelectionLPT::IsRuntimeRecordCurrent(Entry, FLPTLoadOptions()));
+
+	// A rejected record is not used for selection, the resident collections are merged instead.
+	CollectionAsset->AssetList.Add(FSoftObjectPath(TEXT("/Game/C.C")));
+	PreloadSelectionLPT::FPreloadListLPT PreloadList;
+	PreloadSelectionLPT::BuildPreloadList(Entry, FLPTLoadOptions(), PreloadList, false);
+	TestEqual(TEXT("Unbaked selection merges the current collection"), PreloadList.Paths.Num(), 3);
+
+	FLevelPreloadEntryLPT UnbakedEntry;
+	UnbakedEntry.Collections.Add(CollectionAsset);
+	TestFalse(TEXT("Unbaked entry has no current record"), PreloadSelectionLPT::IsRuntimeRecordCurrent(UnbakedEntry, FLPTLoadOptions()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPreloadSelectionMergedListTestLPT, "LPT.PreloadSelection.MergedList",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPreloadSelectionMergedListTestLPT::RunTest(const FString& Parameters)
+{
+	UAssetCollectionDataLPT* CollectionAsset = MakeCollection({ TEXT("/Game/A.A"), TEXT("/Game/B.B") }, 1);
+
+	FLevelPreloadEntryLPT Entry;
+	AddCollectionRecord(Entry, CollectionAsset);
+
+	FLevelMergedListLPT& MergedList = Entry.RuntimeRecord.MergedLists.AddDefaulted_GetRef();
+	MergedList.Collections.Add(FSoftObjectPath(CollectionAsset));
+	MergedList.CollectionKeys.Add(CollectionAsset->CollectionKey);
+	MergedList.AssetList = CollectionAsset->AssetList;
+
+	// Merged lists are not checked against resident collections, the database cook depends on the collection packages.
+	CollectionAsset->AssetList.Add(FSoftObjectPath(TEXT("/Game/C.C")));
+	TestTrue(TEXT("Merged list of the selection is found"), PreloadSelectionLPT::FindSelectedMergedList(Entry, FLPTLoadOptions()) == &MergedList);
+
+	PreloadSelectionLPT::FPreloadListLPT PreloadList;
+	PreloadSelectionLPT::BuildPreloadList(Entry, FLPTLoadOptions(), PreloadList);
+	TestTrue(TEXT("Matching merged list is copied"), PreloadList.Paths == MergedList.AssetList);
+
+	// Weights that do not line up with the asset list.
+	MergedList.AssetCostWeights = { 1 };
+	AddExpectedError(TEXT("does not match its collection records"), EAutomationExpectedErrorFlags::Contains, 2);
+	TestNull(TEXT("Inconsistent merged list is not used"), PreloadSelectionLPT::FindSelectedMergedList(Entry, FLPTLoadOptions()));
+	PreloadSelectionLPT::BuildPreloadList(Entry, FLPTLoadOptions(), PreloadList);
+	TestEqual(TEXT("Inconsistent merged list is merged again"), PreloadList.Paths.Num(), 3);
+
+	return true;
+}
+
+#endif
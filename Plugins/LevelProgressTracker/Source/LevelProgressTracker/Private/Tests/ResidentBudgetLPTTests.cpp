@@ -0,0 +1,87 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "Misc/AutomationTest.h"
+#include "ResidentBudgetLPT.h"
+#include "SubsytemLPT.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int64 InstanceCostWeight = 100 * 1024 * 1024;
+
+	// Level instance that was shown. Its handles are released, its cost weight stays counted until unload.
+	FLevelState MakeLoadedInstanceState()
+	{
+		FLevelState LevelState;
+		LevelState.LoadMethod = ELevelLoadMethod::LevelStreaming;
+		LevelState.bPreloadCompleted = true;
+		LevelState.bLevelRequested = true;
+		LevelState.LevelInstanceState.IsLoaded = true;
+		LevelState.ResidentCostWeight = InstanceCostWeight;
+		return LevelState;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResidentBudgetStackedInstancesTestLPT, "LPT.ResidentBudget.StackedInstances",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FResidentBudgetStackedInstancesTestLPT::RunTest(const FString& Parameters)
+{
+	// Four stacked LoadLevelInstanceLPT calls of 100 MB each against a 400 MB budget.
+	constexpr int64 BudgetBytes = 4 * InstanceCostWeight;
+
+	TArray<FLevelState> LevelStates;
+	for (int32 InstanceIndex = 0; InstanceIndex < 3; ++InstanceIndex)
+	{
+		LevelStates.Add(MakeLoadedInstanceState());
+	}
+
+	// Preload finished, level instance requested and still opening.
+	FLevelState& OpeningState = LevelStates.Add_GetRef(MakeLoadedInstanceState());
+	OpeningState.LevelInstanceState.IsLoaded = false;
+
+	int64 HeldCostWeight = 0;
+	bool bHasRunningPreload = false;
+	for (const FLevelState& LevelState : LevelStates)
+	{
+		TestTrue(TEXT("Every state is counted"), ResidentBudgetLPT::HoldsResidentAssets(LevelState));
+		HeldCostWeight += LevelState.ResidentCostWeight;
+		bHasRunningPreload |= ResidentBudgetLPT::IsPreloadRunning(LevelState);
+	}
+
+	TestFalse(TEXT("Loaded instance is not a running preload"), ResidentBudgetLPT::IsPreloadRunning(LevelStates[0]));
+	TestTrue(TEXT("Opening instance is a running preload"), ResidentBudgetLPT::IsPreloadRunning(OpeningState));
+
+	// A fifth instance does not fit. The prefetch is released and the preload waits for the opening instance.
+	ResidentBudgetLPT::FBudgetDecisionLPT Decision = ResidentBudgetLPT::DecideIncomingPreload(HeldCostWeight, InstanceCostWeight, bHasRunningPreload, false, InstanceCostWeight, BudgetBytes);
+	TestTrue(TEXT("Prefetch is released"), Decision.bReleasePrefetch);
+	TestTrue(TEXT("Incoming preload waits for the running one"), Decision.bDeferIncoming);
+	TestFalse(TEXT("Deferred preload does not exceed the budget"), Decision.bExceedsBudget);
+
+	// Pinned preloads never wait.
+	Decision = ResidentBudgetLPT::DecideIncomingPreload(HeldCostWeight, 0, bHasRunningPreload, true, InstanceCostWeight, BudgetBytes);
+	TestFalse(TEXT("Pinned preload is not deferred"), Decision.bDeferIncoming);
+	TestTrue(TEXT("Pinned preload exceeds the budget"), Decision.bExceedsBudget);
+
+	// Once the opening instance is shown nothing is left to wait for, the preload starts over the budget.
+	OpeningState.LevelInstanceState.IsLoaded = true;
+	TestFalse(TEXT("Shown instance is not a running preload"), ResidentBudgetLPT::IsPreloadRunning(OpeningState));
+	Decision = ResidentBudgetLPT::DecideIncomingPreload(HeldCostWeight, 0, false, false, InstanceCostWeight, BudgetBytes);
+	TestFalse(TEXT("Preload is not deferred without running preloads"), Decision.bDeferIncoming);
+	TestTrue(TEXT("Preload exceeds the budget"), Decision.bExceedsBudget);
+
+	// Releasing the prefetch alone makes room.
+	Decision = ResidentBudgetLPT::DecideIncomingPreload(3 * InstanceCostWeight, InstanceCostWeight, true, false, InstanceCostWeight, BudgetBytes);
+	TestTrue(TEXT("Prefetch is released"), Decision.bReleasePrefetch);
+	TestFalse(TEXT("Preload fits after the prefetch is released"), Decision.bDeferIncoming || Decision.bExceedsBudget);
+
+	// Deferred and cancelled states hold nothing.
+	FLevelState DeferredState = MakeLoadedInstanceState();
+	DeferredState.bBudgetDeferred = true;
+	TestFalse(TEXT("Deferred state is not counted"), ResidentBudgetLPT::HoldsResidentAssets(DeferredState));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,89 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "TraceLPT.h"
+
+#if LPT_TRACE_ENABLED
+#include "HAL/PlatformTime.h"
+#include "Trace/Trace.inl"
+
+UE_TRACE_CHANNEL_DEFINE(LPTChannel)
+
+UE_TRACE_EVENT_BEGIN(LPT, ChunkRequested)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, LoadHandle)
+	UE_TRACE_EVENT_FIELD(int32, StartIndex)
+	UE_TRACE_EVENT_FIELD(int32, AssetCount)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(LPT, ChunkCompleted)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, LoadHandle)
+	UE_TRACE_EVENT_FIELD(int32, StartIndex)
+	UE_TRACE_EVENT_FIELD(int32, AssetCount)
+	UE_TRACE_EVENT_FIELD(double, Duration)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(LPT, LevelRequested)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, LoadHandle)
+	UE_TRACE_EVENT_FIELD(bool, IsStreamingLevel)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, LevelName)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(LPT, LevelLoaded)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, LoadHandle)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, LevelName)
+UE_TRACE_EVENT_END()
+
+namespace TraceLPT
+{
+	void ChunkRequested(int32 LoadHandleId, int32 StartIndex, int32 AssetCount)
+	{
+		UE_TRACE_LOG(LPT, ChunkRequested, LPTChannel)
+			<< ChunkRequested.Cycle(FPlatformTime::Cycles64())
+			<< ChunkRequested.LoadHandle(LoadHandleId)
+			<< ChunkRequested.StartIndex(StartIndex)
+			<< ChunkRequested.AssetCount(AssetCount);
+	}
+
+	void ChunkCompleted(int32 LoadHandleId, int32 StartIndex, int32 AssetCount, double Duration)
+	{
+		UE_TRACE_LOG(LPT, ChunkCompleted, LPTChannel)
+			<< ChunkCompleted.Cycle(FPlatformTime::Cycles64())
+			<< ChunkCompleted.LoadHandle(LoadHandleId)
+			<< ChunkCompleted.StartIndex(StartIndex)
+			<< ChunkCompleted.AssetCount(AssetCount)
+			<< ChunkCompleted.Duration(Duration);
+	}
+
+	void LevelRequested(int32 LoadHandleId, FName LevelName, bool bIsStreamingLevel)
+	{
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(LPTChannel))
+		{
+			return;
+		}
+
+		const FString LevelNameString = LevelName.ToString();
+		UE_TRACE_LOG(LPT, LevelRequested, LPTChannel)
+			<< LevelRequested.Cycle(FPlatformTime::Cycles64())
+			<< LevelRequested.LoadHandle(LoadHandleId)
+			<< LevelRequested.IsStreamingLevel(bIsStreamingLevel)
+			<< LevelRequested.LevelName(*LevelNameString, LevelNameString.Len());
+	}
+
+	void LevelLoaded(int32 LoadHandleId, FName LevelName)
+	{
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(LPTChannel))
+		{
+			return;
+		}
+
+		const FString LevelNameString = LevelName.ToString();
+		UE_TRACE_LOG(LPT, LevelLoaded, LPTChannel)
+			<< LevelLoaded.Cycle(FPlatformTime::Cycles64())
+			<< LevelLoaded.LoadHandle(LoadHandleId)
+			<< LevelLoaded.LevelName(*LevelNameString, LevelNameString.Len());
+	}
+}
+#endif
@@ -0,0 +1,40 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+// Unreal Insights instrumentation of the LPT loading pipeline. Enable with -trace=cpu,lpt.
+#define LPT_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if LPT_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(LPTChannel)
+
+#define LPT_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, LPTChannel)
+#else
+#define LPT_TRACE_SCOPE(Name)
+#endif
+
+namespace TraceLPT
+{
+#if LPT_TRACE_ENABLED
+	// A chunk of preload assets was requested.
+	void ChunkRequested(int32 LoadHandleId, int32 StartIndex, int32 AssetCount);
+
+	// A chunk of preload assets completed. Duration is measured from its request in seconds.
+	void ChunkCompleted(int32 LoadHandleId, int32 StartIndex, int32 AssetCount, double Duration);
+
+	// The level open or level instance load was requested after preloading.
+	void LevelRequested(int32 LoadHandleId, FName LevelName, bool bIsStreamingLevel);
+
+	// The level finished loading: the new map was loaded or the level instance was shown.
+	void LevelLoaded(int32 LoadHandleId, FName LevelName);
+#else
+	inline void ChunkRequested(int32, int32, int32) {}
+	inline void ChunkCompleted(int32, int32, int32, double) {}
+	inline void LevelRequested(int32, FName, bool) {}
+	inline void LevelLoaded(int32, FName) {}
+#endif
+}
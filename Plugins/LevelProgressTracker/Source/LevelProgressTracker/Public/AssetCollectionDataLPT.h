@@ -5,10 +5,14 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "GameplayTagContainer.h"
+#include "Misc/Optional.h"
+#include "SettingsLPT.h"
 #include "WorldPartition/DataLayer/DataLayerAsset.h"
 
 #include "AssetCollectionDataLPT.generated.h"
 
+class ITargetPlatform;
+
 UCLASS(BlueprintType)
 class LEVELPROGRESSTRACKER_API UAssetCollectionDataLPT : public UDataAsset
 {
@@ -24,6 +28,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset List and Layers")
 	FGameplayTagContainer GroupTags;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset List and Layers", meta = (ToolTip = "If true, preloads that select this collection are never deferred by the resident memory budget."))
+	bool bPinResident = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset List and Layers", meta = (DisplayName = "Target Data Layers"))
 	TArray<TSoftObjectPtr<UDataLayerAsset>> TargetDataLayers;
 
@@ -36,6 +43,94 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset List and Layers")
 	TArray<FSoftObjectPath> AssetList;
 
+	UPROPERTY(VisibleAnywhere, Category = "Asset List and Layers", meta = (ToolTip = "Auto-generated cost weight for each AssetList entry (on-disk package size in bytes). Used for cost-weighted preload progress. Not editable."))
+	TArray<int64> AssetCostWeights;
+
+	UPROPERTY(VisibleAnywhere, Category = "Asset List and Layers", meta = (ToolTip = "Auto-generated priority tier for each AssetList entry. Empty when every asset is in the normal tier. Not editable."))
+	TArray<ELPTAssetPriorityTier> AssetTiers;
+
 	UPROPERTY(VisibleAnywhere, Category = "Asset List and Layers", meta = (ToolTip = "Auto-generated checksum of collection content. Used to detect outdated preload lists. Not editable."))
 	uint32 CollectionContentHash = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Asset List and Layers", meta = (ToolTip = "Cook-time position of each AssetList entry's package in the cooked containers. Empty in the editor, where AssetList is kept in path order. Not editable."))
+	TArray<int32> AssetLoadOrderKeys;
+
+	//~UObject
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostSave(FObjectPostSaveContext SaveContext) override;
+#endif
+	//~End UObject
+
+	/** Order the editor keeps AssetList in. */
+	static bool AssetPathLess(const FSoftObjectPath& A, const FSoftObjectPath& B)
+	{
+		return A.LexicalLess(B);
+	}
+
+	/** Order of AssetList entries: load order key first, then path. Runtime merges lists in this order in one pass. */
+	static bool AssetOrderLess(int32 KeyA, const FSoftObjectPath& A, int32 KeyB, const FSoftObjectPath& B)
+	{
+		return KeyA != KeyB ? KeyA < KeyB : AssetPathLess(A, B);
+	}
+
+	/** True if AssetList was reordered at cook time and every entry has a load order key. */
+	bool HasAssetLoadOrder() const
+	{
+		return !AssetLoadOrderKeys.IsEmpty() && AssetLoadOrderKeys.Num() == AssetList.Num();
+	}
+
+	/** Returns load order key of the AssetList entry. Lists without cook-time order use 0, which reduces to path order. */
+	int32 GetAssetLoadOrderKey(int32 AssetIndex) const
+	{
+		return HasAssetLoadOrder() ? AssetLoadOrderKeys[AssetIndex] : 0;
+	}
+
+	/** True if AssetList is sorted by AssetOrderLess. */
+	bool IsAssetListSorted() const;
+
+#if WITH_EDITOR
+	/**
+	 * Reorders AssetList by the package order of the platform's cooked containers, or restores path order when disabled
+	 * in project settings. Packages listed in the FileOpenOrder logs keep their log position, which is the container
+	 * order. Unlisted packages follow all listed ones sorted by dependency height only. That is an approximation of load
+	 * order, not their position in the containers. Used on cook-only copies and on the package being cooked.
+	 */
+	void ApplyCookLoadOrder(const ITargetPlatform* TargetPlatform);
+
+	/** Sorts AssetList back into path order and drops the load order keys. */
+	void RestorePathOrder();
+#endif
+
+	/** Returns cost weight of the AssetList entry. Entries without a generated weight count as 1. */
+	int64 GetAssetCostWeight(int32 AssetIndex) const
+	{
+		return AssetCostWeights.IsValidIndex(AssetIndex) ? FMath::Max<int64>(1, AssetCostWeights[AssetIndex]) : 1;
+	}
+
+	/** Returns priority tier of the AssetList entry. Entries without a generated tier are normal. */
+	ELPTAssetPriorityTier GetAssetPriorityTier(int32 AssetIndex) const
+	{
+		return AssetTiers.IsValidIndex(AssetIndex) ? AssetTiers[AssetIndex] : ELPTAssetPriorityTier::Normal;
+	}
+
+private:
+#if WITH_EDITOR
+	/** Sorts AssetList with its weights and tiers by AssetOrderLess using the given keys, and stores the keys. */
+	void SortAssetListByLoadOrder(TArray<int32>&& LoadOrderKeys);
+#endif
+
+#if WITH_EDITORONLY_DATA
+	// Editor order of AssetList and its parallel arrays.
+	struct FEditorAssetOrderLPT
+	{
+		TArray<FSoftObjectPath> AssetList;
+		TArray<int64> AssetCostWeights;
+		TArray<ELPTAssetPriorityTier> AssetTiers;
+		TArray<int32> AssetLoadOrderKeys;
+	};
+
+	// Set between PreSave and PostSave of a cook, while the cook-ordered lists are written.
+	TOptional<FEditorAssetOrderLPT> CookSaveEditorOrder;
+#endif
 };
@@ -36,6 +36,19 @@ public:
 	TArray<FString> TargetCellRules;
 };
 
+USTRUCT(BlueprintType)
+struct FLPTPrecomputedSelectionLPT
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection Presets")
+	TArray<FName> CollectionKeys;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection Presets")
+	FGameplayTagContainer GroupTags;
+};
+
 UCLASS(BlueprintType)
 class LEVELPROGRESSTRACKER_API UAssetFilterSettingsLPT : public UDataAsset
 {
@@ -54,12 +67,36 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Filtering", meta = (ContentDir, LongPackageName, ForceShowPluginContent))
 	TArray<FDirectoryPath> FolderRules;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Filtering", meta = (ToolTip = "Preloaded assets that overfetch analysis found unused after the level opened. Imported from Saved/LPT/Overfetch with the 'LPT Overfetch' editor toolbar action. Suggestions are not applied; move entries to AssetRules in exclusion mode to drop them from generated collections."))
+	TArray<FSoftObjectPath> SuggestedAssetExclusions;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ToolTip = "If true, preload assets are requested in chunks. If false, all assets are requested as one aggregated batch."))
 	bool bUseChunkedPreload = true;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "1", UIMin = "1", ToolTip = "Number of assets per preload chunk. 1 means per-asset loading; larger values batch assets into groups for better performance."))
 	int32 PreloadChunkSize = 32;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (EditCondition = "bUseChunkedPreload", ToolTip = "If true, chunk size adapts to measured chunk load time within Min/Max bounds. PreloadChunkSize is used as the starting size. If false, PreloadChunkSize is used as a fixed value."))
+	bool bUseAdaptiveChunkSize = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bUseChunkedPreload && bUseAdaptiveChunkSize", ToolTip = "Lower bound for adaptive chunk size."))
+	int32 MinAdaptiveChunkSize = 8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bUseChunkedPreload && bUseAdaptiveChunkSize", ToolTip = "Upper bound for adaptive chunk size."))
+	int32 MaxAdaptiveChunkSize = 512;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "0.01", UIMin = "0.01", Units = "s", EditCondition = "bUseChunkedPreload && bUseAdaptiveChunkSize", ToolTip = "Desired time in seconds between chunk completions. Faster chunks grow, slower chunks shrink."))
+	float TargetChunkLoadTime = 0.1f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "1", UIMin = "1", ClampMax = "16", UIMax = "16", EditCondition = "bUseChunkedPreload", ToolTip = "Number of chunk requests kept in flight at the same time. 1 is strictly serial; larger values overlap chunk loading with completion handling."))
+	int32 MaxChunksInFlight = 2;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ToolTip = "Backend that requests preload assets. Package Async loads deduplicated packages with LoadPackageAsync and reports progress per package. Project Default uses the project setting."))
+	ELPTPreloadBackend PreloadBackend = ELPTPreloadBackend::ProjectDefault;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers", meta = (ToolTip = "Priority tier rules for collected assets. Critical assets are requested first at the highest async priority, deferred assets last."))
+	FLPTAssetTierRules AssetTierRules;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Partition")
 	bool bAllowWorldPartitionAutoScan = false;
 
@@ -69,6 +106,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection Presets", meta = (ToolTip = "Optional collection presets that can be materialized into AssetCollectionDataLPT assets."))
 	TArray<FLPTCollectionPresetLPT> CollectionPresets;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collection Presets", meta = (ToolTip = "CollectionKeys and GroupTags combinations passed in load options at runtime. Their merged preload lists are precomputed into the database. The default selection is always precomputed."))
+	TArray<FLPTPrecomputedSelectionLPT> PrecomputedSelections;
+
 	FLPTFilterSettings ToFilterSettings() const;
 	void InitializeDefaultsFromProjectSettings(const ULevelProgressTrackerSettings* Settings);
 };
@@ -46,5 +46,11 @@ public:
 		FString& OutDatabasePackagePath,
 		FSoftObjectPath& OutDatabaseObjectPath
 	);
+
+	// Returns the file in Saved/LPT/Learned where record mode stores assets missing from the level's preload set.
+	static FString GetLearnedAssetsFilePath(const FString& LevelPackagePath);
+
+	// Returns the file in Saved/LPT/Overfetch where overfetch analysis stores the report of the level. Timestamp "*" gives a pattern for every report of the level.
+	static FString GetOverfetchReportFilePath(const FString& LevelPackagePath, const FString& Timestamp);
 };
 
@@ -9,8 +9,136 @@
 
 #include "LevelPreloadDatabaseLPT.generated.h"
 
+class ITargetPlatform;
 class UWorld;
 
+USTRUCT(BlueprintType)
+struct FLevelTransitionLPT
+{
+	GENERATED_BODY()
+
+public:
+	/* Level that is likely opened after the owning level. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "LPT")
+	TSoftObjectPtr<UWorld> TargetLevel;
+
+	/* Relative likelihood of this transition. Learned transitions are added on top of it at runtime. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "LPT", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float Weight = 1.f;
+};
+
+USTRUCT(BlueprintType)
+struct FLevelCollectionRecordLPT
+{
+	GENERATED_BODY()
+
+public:
+	/* Collection asset. Loaded at runtime only when it is selected and no merged list covers the selection. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	TSoftObjectPtr<UAssetCollectionDataLPT> Collection;
+
+	/* CollectionKey of the collection asset at bake time. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	FName CollectionKey;
+
+	/* GroupTags of the collection asset at bake time. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	FGameplayTagContainer GroupTags;
+
+	/* Number of AssetList entries at bake time. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	int32 AssetCount = 0;
+
+	/* CollectionContentHash of the collection asset at bake time. When the collection is loaded for selection, runtime rejects the record if it differs. */
+	UPROPERTY(VisibleAnywhere, Category = "LPT")
+	uint32 CollectionContentHash = 0;
+};
+
+/* Deduplicated, tier-sorted preload list of one collection selection. Baked by the editor. */
+USTRUCT(BlueprintType)
+struct FLevelMergedListLPT
+{
+	GENERATED_BODY()
+
+public:
+	/* Selected collections in record order. Identifies the selection the list was merged from. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	TArray<FSoftObjectPath> Collections;
+
+	/* CollectionKey of each selected collection. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	TArray<FName> CollectionKeys;
+
+	/* True if any selected collection has bPinResident set. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	bool bPinResident = false;
+
+	/* True if every selected collection carried cook load order keys, so AssetList follows the container order. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	bool bInLoadOrder = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	TArray<FSoftObjectPath> AssetList;
+
+	/* Empty when no selected collection has cost weights. */
+	UPROPERTY(VisibleAnywhere, Category = "LPT")
+	TArray<int64> AssetCostWeights;
+
+	/* Empty when no selected collection has priority tiers. */
+	UPROPERTY(VisibleAnywhere, Category = "LPT")
+	TArray<ELPTAssetPriorityTier> AssetTiers;
+};
+
+/* Compact copy of the entry data needed by runtime selection and scheduling. Baked into the cooked database only. */
+USTRUCT(BlueprintType)
+struct FLevelRuntimeRecordLPT
+{
+	GENERATED_BODY()
+
+public:
+	/* False in the editor and for entries cooked before runtime records existed. Runtime then falls back to loading filter settings and every collection. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	bool bBaked = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	bool bUseChunkedPreload = true;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	int32 PreloadChunkSize = 32;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	bool bUseAdaptiveChunkSize = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	int32 MinAdaptiveChunkSize = 8;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	int32 MaxAdaptiveChunkSize = 512;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	float TargetChunkLoadTime = 0.1f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	int32 MaxChunksInFlight = 2;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	ELPTPreloadBackend PreloadBackend = ELPTPreloadBackend::ProjectDefault;
+
+	/* One record per valid entry collection, in entry order. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	TArray<FLevelCollectionRecordLPT> Collections;
+
+	/* Merged lists of the default selection and of the PrecomputedSelections of the filter settings. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	TArray<FLevelMergedListLPT> MergedLists;
+
+	/** Copies chunk scheduling and backend fields from filter settings. */
+	void CopyChunkSettingsFrom(const FLPTFilterSettings& FilterSettings);
+
+	/** Copies chunk scheduling and backend fields into filter settings, leaving filter rules untouched. */
+	void CopyChunkSettingsTo(FLPTFilterSettings& OutFilterSettings) const;
+};
+
 USTRUCT(BlueprintType)
 struct FLevelPreloadEntryLPT
 {
@@ -33,9 +161,17 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "LPT")
 	TArray<TSoftObjectPtr<UAssetCollectionDataLPT>> Collections;
 
+	/* Authored transition graph edges. Used for speculative prefetch of the likely next level. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "LPT")
+	TArray<FLevelTransitionLPT> NextLevels;
+
 	/* Hash of level state and filter settings used to validate generated content. */
 	UPROPERTY(VisibleAnywhere, Category = "LPT")
 	uint32 LevelStateHash = 0;
+
+	/* Runtime selection data baked from FilterSettings and Collections. Not editable. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT")
+	FLevelRuntimeRecordLPT RuntimeRecord;
 };
 
 UCLASS(BlueprintType)
@@ -47,6 +183,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "LPT")
 	TArray<FLevelPreloadEntryLPT> Levels;
 
+	//~UObject
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void OnCookEvent(UE::Cook::ECookEvent CookEvent, UE::Cook::FCookEventContext& CookContext) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~End UObject
+
+	/** Rebuilds the transient level package name to entry index lookup from Levels. */
+	void RebuildLevelIndex() const;
+
 	/** Finds a level entry by level soft pointer. Returns nullptr when no entry exists. */
 	const FLevelPreloadEntryLPT* FindEntryByLevel(const TSoftObjectPtr<UWorld>& Level) const;
 
@@ -58,5 +206,30 @@ public:
 
 	/** Removes invalid and duplicate collection references while preserving original order. */
 	static void DeduplicateCollections(FLevelPreloadEntryLPT& Entry);
+
+#if WITH_EDITOR
+	/**
+	 * Rebuilds the runtime record of the entry from its filter settings and collection assets. Loads them synchronously,
+	 * so it runs only while the database is cooked. When cooking for CookTargetPlatform, merged lists are built from
+	 * copies of the collections in the cooked load order. The collection assets themselves are not modified.
+	 */
+	static void BakeRuntimeRecord(FLevelPreloadEntryLPT& Entry, const ITargetPlatform* CookTargetPlatform = nullptr);
+#endif
+
+private:
+	/** Returns index of the entry for level path, rebuilding the lookup if it is out of sync with Levels. */
+	int32 FindEntryIndex(const FSoftObjectPath& LevelPath) const;
+
+	/** Removes all duplicate entries for the same level, keeping the first one. */
+	void RemoveDuplicateEntries();
+
+	// Transient lookup from level long package name to index in Levels. Not serialized.
+	mutable TMap<FName, int32> LevelIndexByPackage;
+
+	// Levels.Num() at the last index rebuild. A mismatch means Levels was changed directly.
+	mutable int32 IndexedLevelCount = INDEX_NONE;
+
+	// Set by the index rebuild when Levels contains more than one entry for the same level.
+	mutable bool bHasDuplicateEntries = false;
 };
 
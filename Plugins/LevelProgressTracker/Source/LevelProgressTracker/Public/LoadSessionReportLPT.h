@@ -0,0 +1,136 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "UObject/Object.h"
+
+#include "LoadSessionReportLPT.generated.h"
+
+// Measured load of one preload chunk.
+USTRUCT(BlueprintType)
+struct FLPTChunkReport
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	int32 StartIndex = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	int32 AssetCount = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (Units = "s"))
+	float Duration = 0.f;
+};
+
+// Data of one level load session, from the load request until the level is loaded.
+USTRUCT(BlueprintType)
+struct FLPTLoadSessionReportData
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	FName LevelName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	FString LevelPath;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	int32 LoadHandleId = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	bool bIsStreamingLevel = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "True if the load was cancelled or retargeted before the level was requested."))
+	bool bCancelled = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Reason the level state was abandoned, e.g. a travel failure or level open timeout. Empty if the level loaded."))
+	FString FailureReason;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	TArray<FName> RequestedCollectionKeys;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	FGameplayTagContainer RequestedGroupTags;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	TArray<FName> SelectedCollectionKeys;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	TArray<FString> SelectedCollections;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Number of assets requested by the preload."))
+	int32 TotalAssets = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Number of selected assets kept from the previous level instead of being requested."))
+	int32 SharedAssets = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Sum of generated cost weights (on-disk size) of requested assets. 0 if collections have no weights."))
+	int64 TotalCostWeight = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	bool bChunkedPreload = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	bool bPackagePreload = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	int32 InitialChunkSize = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Chunk size at the end of the preload. Differs from InitialChunkSize in adaptive mode."))
+	int32 FinalChunkSize = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	TArray<FLPTChunkReport> Chunks;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	TArray<FLPTChunkReport> SlowestChunks;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (Units = "s", ToolTip = "Time from the load request to 100% preload."))
+	float TimeToPreloadComplete = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (Units = "s", ToolTip = "Time from the level open or level instance request to the loaded map or shown instance."))
+	float TimeToLevelLoaded = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (Units = "s"))
+	float TotalTime = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Preload paths that were not resident after their request completed."))
+	TArray<FString> FailedPaths;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Number of preload stalls reported by the watchdog."))
+	int32 PreloadStalls = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Synchronous package loads that happened while the preload was active. Development builds only."))
+	TArray<FString> SyncLoadsDuringPreload;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Number of async loading flushes that happened while the preload was active. Development builds only."))
+	int32 FlushesDuringPreload = 0;
+};
+
+/**
+ * Report of the last finished level load session. Kept in memory, and in non-shipping builds also written as JSON to
+ * Saved/LPT/Sessions when enabled in project settings.
+ */
+UCLASS(BlueprintType)
+class LEVELPROGRESSTRACKER_API ULPTLoadSessionReport : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report")
+	FLPTLoadSessionReportData Data;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Report", meta = (ToolTip = "Path of the JSON file the report is written to. Set when the write is queued, the file appears once the background write finishes. Empty if the report is not written."))
+	FString FilePath;
+
+	// Returns the report serialized as JSON.
+	UFUNCTION(BlueprintPure, Category = "LPT Report")
+	FString ToJsonString() const;
+
+	// Queues a background task that serializes a copy of the report and writes it to Saved/LPT/Sessions. Stores the file path.
+	void WriteToFileAsync();
+};
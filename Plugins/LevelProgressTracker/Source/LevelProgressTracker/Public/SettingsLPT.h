@@ -49,6 +49,76 @@ struct FLPTAssetClassFilter
 	bool bIncludeDataAssets = true;
 };
 
+/**
+ * Load priority tier of a preload asset. Critical assets are requested first at the highest async priority.
+ */
+UENUM(BlueprintType)
+enum class ELPTAssetPriorityTier : uint8
+{
+	Critical UMETA(DisplayName = "Critical"),
+	Normal UMETA(DisplayName = "Normal"),
+	Deferred UMETA(DisplayName = "Deferred")
+};
+
+/* Runtime backend that requests preload assets. */
+UENUM(BlueprintType)
+enum class ELPTPreloadBackend : uint8
+{
+	ProjectDefault UMETA(DisplayName = "Project Default"),
+	StreamableManager UMETA(DisplayName = "Streamable Manager"),
+	PackageAsync UMETA(DisplayName = "Package Async")
+};
+
+/**
+ * Priority tier rules assigned to collected assets at generation time.
+ * Explicit asset lists win over class categories.
+ */
+USTRUCT(BlueprintType)
+struct FLPTAssetTierRules
+{
+	GENERATED_BODY()
+
+	/* Tier of static mesh assets. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	ELPTAssetPriorityTier StaticMeshTier = ELPTAssetPriorityTier::Normal;
+
+	/* Tier of skeletal mesh assets. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	ELPTAssetPriorityTier SkeletalMeshTier = ELPTAssetPriorityTier::Normal;
+
+	/* Tier of material-related assets (materials, material instances/functions/collections, textures). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	ELPTAssetPriorityTier MaterialTier = ELPTAssetPriorityTier::Normal;
+
+	/* Tier of Niagara assets. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	ELPTAssetPriorityTier NiagaraTier = ELPTAssetPriorityTier::Normal;
+
+	/* Tier of sound assets. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	ELPTAssetPriorityTier SoundTier = ELPTAssetPriorityTier::Normal;
+
+	/* Tier of Widget Blueprint assets. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	ELPTAssetPriorityTier WidgetTier = ELPTAssetPriorityTier::Normal;
+
+	/* Tier of data asset types. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	ELPTAssetPriorityTier DataAssetTier = ELPTAssetPriorityTier::Normal;
+
+	/* Tier of assets that match none of the categories above. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	ELPTAssetPriorityTier OtherTier = ELPTAssetPriorityTier::Normal;
+
+	/* Assets always placed in the critical tier, for example the player character. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	TArray<FSoftObjectPath> CriticalAssets;
+
+	/* Assets always placed in the deferred tier. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	TArray<FSoftObjectPath> DeferredAssets;
+};
+
 /**
  * Filtering and World Partition generation rules used by a single level entry.
  */
@@ -81,6 +151,34 @@ struct FLPTFilterSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "1", UIMin = "1", ToolTip = "Number of assets per preload chunk. 1 means per-asset loading; larger values batch assets into groups for better performance."))
 	int32 PreloadChunkSize = 32;
 
+	/* If true, chunk size adapts to measured chunk load time within Min/Max bounds. PreloadChunkSize is used as the starting size. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (EditCondition = "bUseChunkedPreload", ToolTip = "If true, chunk size adapts to measured chunk load time within Min/Max bounds. PreloadChunkSize is used as the starting size."))
+	bool bUseAdaptiveChunkSize = false;
+
+	/* Lower bound for adaptive chunk size. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bUseChunkedPreload && bUseAdaptiveChunkSize", ToolTip = "Lower bound for adaptive chunk size."))
+	int32 MinAdaptiveChunkSize = 8;
+
+	/* Upper bound for adaptive chunk size. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bUseChunkedPreload && bUseAdaptiveChunkSize", ToolTip = "Upper bound for adaptive chunk size."))
+	int32 MaxAdaptiveChunkSize = 512;
+
+	/* Desired time in seconds between chunk completions. Faster chunks grow, slower chunks shrink. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "0.01", UIMin = "0.01", Units = "s", EditCondition = "bUseChunkedPreload && bUseAdaptiveChunkSize", ToolTip = "Desired time in seconds between chunk completions. Faster chunks grow, slower chunks shrink."))
+	float TargetChunkLoadTime = 0.1f;
+
+	/* Number of chunk requests kept in flight at the same time. 1 is strictly serial; larger values overlap chunk loading with completion handling. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ClampMin = "1", UIMin = "1", ClampMax = "16", UIMax = "16", EditCondition = "bUseChunkedPreload", ToolTip = "Number of chunk requests kept in flight at the same time. 1 is strictly serial; larger values overlap chunk loading with completion handling."))
+	int32 MaxChunksInFlight = 2;
+
+	/* Backend that requests preload assets. Project Default uses the project setting. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preload Progress", meta = (ToolTip = "Backend that requests preload assets. Package Async loads deduplicated packages with LoadPackageAsync and reports progress per package. Project Default uses the project setting."))
+	ELPTPreloadBackend PreloadBackend = ELPTPreloadBackend::ProjectDefault;
+
+	/* Priority tier rules for collected assets. Critical assets are requested first at the highest async priority. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Priority Tiers")
+	FLPTAssetTierRules AssetTierRules;
+
 	/* Enables safe World Partition actor scan using only currently loaded actors. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Partition")
 	bool bAllowWorldPartitionAutoScan = false;
@@ -154,10 +252,81 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Database", meta = (ToolTip = "Folder for AssetFilterSettingsLPT assets. If empty, defaults to '<Database Folder>/AssetFilterSettings'.", ContentDir, LongPackageName, ForceShowPluginContent))
 	FDirectoryPath AssetFilterSettingsFolder;
 
+	/* Keeps the preload database referenced for the whole game instance lifetime once the startup warm-up finishes. */
+	UPROPERTY(EditAnywhere, Config, Category = "Database", meta = (ToolTip = "If true, the preload database loaded asynchronously at subsystem startup stays pinned in memory. If false, it can be garbage collected between transitions and is reloaded asynchronously on demand."))
+	bool bKeepPreloadDatabaseLoaded = true;
+
+	/* Budget for preloaded assets, measured by generated asset cost weights (on-disk size). 0 disables the budget. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Memory", meta = (ClampMin = "0", UIMin = "0", Units = "MB", ToolTip = "Budget for preloaded assets, measured by generated asset cost weights (on-disk size). Running preloads and loaded level instances count against it until the instance is unloaded. A preload that would exceed the budget first releases the speculative prefetch, then waits for running preloads to finish. Pinned preloads never wait. Collections without cost weights are not counted. 0 disables the budget."))
+	int32 ResidentMemoryBudgetMB = 0;
+
+	/* Minimum progress change between two OnLevelLoadProgressLPT broadcasts of a level. Broadcasts are also limited to one per frame. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Progress", meta = (ClampMin = "0.0", UIMin = "0.0", ClampMax = "1.0", UIMax = "1.0", ToolTip = "Minimum progress change between two OnLevelLoadProgressLPT broadcasts of a level. Broadcasts are also limited to one per frame. Final progress is always broadcast. 0 broadcasts every frame with progress."))
+	float MinProgressBroadcastDelta = 0.f;
+
+	/* Limit of chunk requests in flight across all concurrent level and instance loads. 0 disables the limit. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Scheduler", meta = (ClampMin = "0", UIMin = "0", ToolTip = "Limit of chunk requests in flight across all concurrent level and instance loads. Foreground OpenLevelLPT loads are served first, level instance loads share the remaining slots evenly. 0 disables the limit."))
+	int32 MaxGlobalChunksInFlight = 4;
+
+	/* Backend used by levels whose filter settings keep Project Default. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Scheduler", meta = (ToolTip = "Backend used by levels whose filter settings keep Project Default. Streamable Manager requests object paths in chunks or one batch. Package Async requests deduplicated packages with LoadPackageAsync, all at once with tier priorities, and reports progress per package."))
+	ELPTPreloadBackend DefaultPreloadBackend = ELPTPreloadBackend::StreamableManager;
+
+	/* Keeps preload assets shared with the current level referenced across OpenLevel and loads only the difference. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Transitions", meta = (ToolTip = "If true, preload assets of the target level that are already resident from the current level's preload set are kept referenced across OpenLevel. Only the difference is requested and counted in progress."))
+	bool bKeepSharedAssetsBetweenLevels = true;
+
+	/* Enables speculative prefetch of the likely next level during idle gameplay. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Prefetch", meta = (ToolTip = "If true, the default collection of the most likely next level is prefetched at low priority during idle gameplay. The next level is chosen from the NextLevels graph in the preload database and from learned transitions."))
+	bool bEnableSpeculativePrefetch = false;
+
+	/* Records level transitions made with OpenLevelLPT and uses them as learned transition graph edges. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Prefetch", meta = (ToolTip = "If true, transitions made with OpenLevelLPT are recorded to Saved/LPT and used as learned edges of the transition graph."))
+	bool bLearnLevelTransitions = true;
+
+	/* Idle time after a level is loaded before prefetch starts. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Prefetch", meta = (ClampMin = "0.0", UIMin = "0.0", Units = "s", EditCondition = "bEnableSpeculativePrefetch", ToolTip = "Time without LPT transitions and engine async loading before prefetch starts."))
+	float PrefetchIdleDelay = 2.f;
+
+	/* Upper bound of prefetched data, measured by generated asset cost weights (on-disk size). 0 disables the cap. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Prefetch", meta = (ClampMin = "0", UIMin = "0", Units = "MB", EditCondition = "bEnableSpeculativePrefetch", ToolTip = "Upper bound of prefetched data, measured by generated asset cost weights (on-disk size). 0 disables the cap."))
+	int32 PrefetchMemoryCapMB = 256;
+
+	/* Records assets loaded after a level opens that were not preloaded. Development builds only. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Record", meta = (ToolTip = "If true, in PIE and non-shipping builds every package loaded during the record window after an OpenLevelLPT level opens, and not part of its preload set, is written to Saved/LPT/Learned. The 'LPT Learned' editor toolbar action merges those assets into the level's Learned collection, which is preloaded together with the Default collection."))
+	bool bRecordMissingAssets = false;
+
+	/* Time after the level opens during which loaded packages are recorded. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Record", meta = (ClampMin = "1.0", UIMin = "1.0", Units = "s", EditCondition = "bRecordMissingAssets", ToolTip = "Time after the level opens during which loaded packages are recorded. Recording also stops when the next LPT load starts."))
+	float RecordWindowDuration = 30.f;
+
+	/* Reports preloaded assets that are no longer alive some time after the level opens. Development builds only. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Record", meta = (ToolTip = "If true, in PIE and non-shipping builds the preload set of an OpenLevelLPT level is checked after the analysis delay and a full garbage collection. Assets that are no longer alive were never used by gameplay. A per-collection report is written to Saved/LPT/Overfetch. The 'LPT Overfetch' editor toolbar action imports the latest report of the opened level into SuggestedAssetExclusions of its filter settings."))
+	bool bAnalyzePreloadOverfetch = false;
+
+	/* Time after the level opens before preloaded assets are checked. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Record", meta = (ClampMin = "1.0", UIMin = "1.0", Units = "s", EditCondition = "bAnalyzePreloadOverfetch", ToolTip = "Time after the level opens before preloaded assets are checked. The analysis is cancelled when the next LPT load starts."))
+	float OverfetchAnalysisDelay = 60.f;
+
+	/* Time without preload progress after which the watchdog logs the still pending assets. 0 disables stall detection. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Watchdog", meta = (ClampMin = "0.0", UIMin = "0.0", Units = "s", ToolTip = "Time without preload progress after which the watchdog logs the assets of the oldest chunk that are still pending. Synchronous loads and async loading flushes during a preload are logged in development builds. 0 disables stall detection."))
+	float PreloadStallThreshold = 5.f;
+
+	/* Time after the level open or level instance request after which a level that never finished loading is released. 0 disables the timeout. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Watchdog", meta = (ClampMin = "0.0", UIMin = "0.0", Units = "s", ToolTip = "Time after the level open or level instance request after which a level that never finished loading is released together with its preload handles and OnLevelLoadFailedLPT is sent. Large levels on slow storage can take minutes, so the timeout is off by default. Travel failures release the level immediately. 0 disables the timeout."))
+	float LevelOpenTimeout = 0.f;
+
+	/* Writes a JSON report of every level load session to Saved/LPT/Sessions. Development builds only. */
+	UPROPERTY(EditAnywhere, Config, Category = "Runtime - Reports", meta = (ToolTip = "If true, a JSON report with selected collections, chunk timings, preload and level load times and failed paths is written to Saved/LPT/Sessions for every level load. The file is written by a background task. Shipping builds never write reports. The last report is always available in memory from GetLastLoadSessionReportLPT."))
+	bool bWriteLoadSessionReports = false;
+
 	/* Enables automatic database generation when a level package is saved. */
 	UPROPERTY(EditAnywhere, Config, Category = "Generation")
 	bool bAutoGenerateOnLevelSave = true;
 
+	UPROPERTY(EditAnywhere, Config, Category = "Cook", meta = (ToolTip = "If true, AssetList of cooked collections and baked merged lists are reordered by the package order of the cooked containers, so preload reads are mostly sequential. The order comes from Build/<Platform>/FileOpenOrder/GameOpenOrder.log and CookerOpenOrder.log. Packages missing there follow all listed ones in dependency order, which is not their container order. Only cooked packages are reordered, editor assets keep path order. Disable to compare load times with the path order."))
+	bool bOrderPreloadListsByIoLocality = true;
+
 	/* Default class-category filter used when creating new AssetFilterSettingsLPT assets. */
 	UPROPERTY(EditAnywhere, Config, Category = "Global Rule Defaults - Class Filter", meta = (ToolTip = "Class-category filter used for automatically collected preload candidates. Explicit asset rules are not affected by this filter."))
 	FLPTAssetClassFilter AssetClassFilter;
@@ -169,5 +338,29 @@ public:
 	/* Default number of assets per preload chunk used when creating new AssetFilterSettingsLPT assets. */
 	UPROPERTY(EditAnywhere, Config, Category = "Global Rule Defaults - Preload Progress", meta = (ClampMin = "1", UIMin = "1", ToolTip = "Number of assets per preload chunk. 1 means per-asset loading; larger values batch assets into groups for better performance."))
 	int32 PreloadChunkSize = 32;
+
+	/* Default adaptive chunk sizing mode used when creating new AssetFilterSettingsLPT assets. */
+	UPROPERTY(EditAnywhere, Config, Category = "Global Rule Defaults - Preload Progress", meta = (ToolTip = "If true, chunk size adapts to measured chunk load time within Min/Max bounds. PreloadChunkSize is used as the starting size."))
+	bool bUseAdaptiveChunkSize = false;
+
+	/* Default lower bound for adaptive chunk size. */
+	UPROPERTY(EditAnywhere, Config, Category = "Global Rule Defaults - Preload Progress", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bUseAdaptiveChunkSize", ToolTip = "Lower bound for adaptive chunk size."))
+	int32 MinAdaptiveChunkSize = 8;
+
+	/* Default upper bound for adaptive chunk size. */
+	UPROPERTY(EditAnywhere, Config, Category = "Global Rule Defaults - Preload Progress", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bUseAdaptiveChunkSize", ToolTip = "Upper bound for adaptive chunk size."))
+	int32 MaxAdaptiveChunkSize = 512;
+
+	/* Default desired time in seconds between chunk completions. */
+	UPROPERTY(EditAnywhere, Config, Category = "Global Rule Defaults - Preload Progress", meta = (ClampMin = "0.01", UIMin = "0.01", Units = "s", EditCondition = "bUseAdaptiveChunkSize", ToolTip = "Desired time in seconds between chunk completions. Faster chunks grow, slower chunks shrink."))
+	float TargetChunkLoadTime = 0.1f;
+
+	/* Default number of chunk requests kept in flight used when creating new AssetFilterSettingsLPT assets. */
+	UPROPERTY(EditAnywhere, Config, Category = "Global Rule Defaults - Preload Progress", meta = (ClampMin = "1", UIMin = "1", ClampMax = "16", UIMax = "16", ToolTip = "Number of chunk requests kept in flight at the same time. 1 is strictly serial; larger values overlap chunk loading with completion handling."))
+	int32 MaxChunksInFlight = 2;
+
+	/* Default priority tier rules used when creating new AssetFilterSettingsLPT assets. */
+	UPROPERTY(EditAnywhere, Config, Category = "Global Rule Defaults - Priority Tiers", meta = (ToolTip = "Priority tier rules for collected assets. Critical assets are requested first at the highest async priority, deferred assets last."))
+	FLPTAssetTierRules AssetTierRules;
 };
 
@@ -26,12 +26,18 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
 #include "Engine/LevelStreamingDynamic.h"
+#include "Containers/Ticker.h"
 #include "GameplayTagContainer.h"
+#include "LoadSessionReportLPT.h"
+#include "SettingsLPT.h"
+#include "UObject/GCObject.h"
 #include "UObject/SoftObjectPath.h"
 
 #include "SubsytemLPT.generated.h"
 
+struct FEndLoadPackageContext;
 struct FStreamableHandle;
 class SWidgetWrapLPT;
 class ULevelPreloadDatabaseLPT;
@@ -44,6 +50,45 @@ enum class ELevelLoadMethod : uint8
 	WorldPartition UMETA(DisplayName = "WorldPartition")
 };
 
+// Identifies one level load request. Returned by OpenLevelLPT and LoadLevelInstanceLPT and passed to native events.
+USTRUCT(BlueprintType)
+struct FLPTLoadHandle
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Subsystem", meta = (ToolTip = "Unique load request ID. 0 is an invalid handle."))
+	int32 Id = 0;
+
+	bool IsValid() const
+	{
+		return Id != 0;
+	}
+
+	bool operator==(const FLPTLoadHandle& Other) const
+	{
+		return Id == Other.Id;
+	}
+
+	bool operator!=(const FLPTLoadHandle& Other) const
+	{
+		return Id != Other.Id;
+	}
+
+	friend uint32 GetTypeHash(const FLPTLoadHandle& Handle)
+	{
+		return ::GetTypeHash(Handle.Id);
+	}
+};
+
+// Progress payload of native progress events.
+struct FLPTLoadProgress
+{
+	float Progress = 0.f;
+	int32 LoadedAssets = 0;
+	int32 TotalAssets = 0;
+};
+
 USTRUCT(BlueprintType)
 struct FLPTLoadOptions
 {
@@ -55,6 +100,96 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LPT Subsystem")
 	FGameplayTagContainer GroupTags;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LPT Subsystem", meta = (ToolTip = "If true, this preload is never deferred by the resident memory budget."))
+	bool bPinPreloadedAssets = false;
+};
+
+// One chunk request of a chunked preload. Kept in FLevelState::InFlightChunks until progress passes it.
+struct FLevelPreloadChunkLPT
+{
+	TSharedPtr<FStreamableHandle> Handle;
+
+	// First index of the chunk in FLevelState::PreloadPaths.
+	int32 StartIndex = 0;
+
+	int32 AssetCount = 0;
+
+	// Asset count before the chunk was extended to the end of its last package. Adaptive sizing is measured against it.
+	int32 ScheduledAssetCount = 0;
+
+	// Sum of PreloadCostWeights of the chunk assets.
+	int64 CostWeight = 0;
+
+	double RequestTime = 0.0;
+
+	bool bCompleted = false;
+};
+
+// One package of a package-granular preload. Its objects are a contiguous range of FPackagePreloadLPT::ObjectPaths.
+struct FPreloadPackageLPT
+{
+	FName PackageName;
+
+	int32 FirstObjectIndex = 0;
+
+	int32 ObjectCount = 0;
+
+	// Sum of preload cost weights of the package objects.
+	int64 CostWeight = 0;
+
+	// Most urgent tier of the package objects.
+	ELPTAssetPriorityTier Tier = ELPTAssetPriorityTier::Normal;
+
+	bool bCompleted = false;
+};
+
+// Package-granular preload requested with LoadPackageAsync. Holds the loaded preload objects referenced,
+// since a package does not keep its objects alive. Released together with the level state handles.
+class FPackagePreloadLPT : public FGCObject
+{
+public:
+	// Groups preload paths by package in first-seen order, so tier order of the paths is kept.
+	void Build(const TArray<FSoftObjectPath>& Paths, const TArray<int64>& CostWeights, const TArray<ELPTAssetPriorityTier>& Tiers);
+
+	// Returns true if every object of the package is already loaded.
+	bool IsPackageResident(int32 PackageIndex) const;
+
+	// Marks the package completed and references its loaded objects. Returns false if it was already completed.
+	bool CompletePackage(int32 PackageIndex);
+
+	//~FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+	//~End FGCObject
+
+	TArray<FPreloadPackageLPT> Packages;
+
+	// Preload paths grouped by package.
+	TArray<FSoftObjectPath> ObjectPaths;
+
+	int32 CompletedPackageCount = 0;
+
+	TArray<TObjectPtr<UObject>> LoadedObjects;
+};
+
+// Speculative prefetch of the likely next level. PackagePath is None when no prefetch is active.
+struct FLevelPrefetchLPT
+{
+	FName PackagePath;
+
+	TSoftObjectPtr<UWorld> LevelSoftPtr;
+
+	// Handle for the level entry collections, released once the prefetch list is built.
+	TSharedPtr<FStreamableHandle> MetadataHandle;
+
+	// Handle keeping prefetched assets referenced. Adopted by the level state when the level is opened.
+	TSharedPtr<FStreamableHandle> Handle;
+
+	// Sum of cost weights of prefetched assets.
+	int64 CostWeight = 0;
+
+	double RequestTime = 0.0;
 };
 
 // Contains data for a streaming embedded game level.
@@ -93,22 +228,139 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Subsystem", meta = (ToolTip = "A common name for a game level."))
 	FName LevelName;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Subsystem", meta = (ToolTip = "Handle of the load request."))
+	FLPTLoadHandle LoadHandle;
+
 	TSharedPtr<FStreamableHandle> Handle;
 
+	// Handle for the batched async load of collection and filter settings assets used for selection.
+	TSharedPtr<FStreamableHandle> MetadataHandle;
+
+	// Set when the baked runtime record no longer matches the cooked collections. Selection then loads every collection.
+	bool bRuntimeRecordRejected = false;
+
 	// Runtime preload mode. True uses chunked requests, false uses a single aggregated request.
 	bool bUseChunkedPreload = true;
 
-	// Number of assets requested per chunk when bUseChunkedPreload is enabled.
+	// True when preload assets are requested per package with LoadPackageAsync instead of the streamable manager.
+	bool bUsePackagePreload = false;
+
+	// Package-granular preload. Valid while bUsePackagePreload assets are loading or held.
+	TSharedPtr<FPackagePreloadLPT> PackagePreload;
+
+	// Number of assets requested per chunk when bUseChunkedPreload is enabled. Updated after each chunk in adaptive mode.
 	int32 PreloadChunkSize = 32;
 
-	// Full preload path list used by chunked mode.
+	// Adaptive chunk sizing. When enabled, PreloadChunkSize grows additively while chunks finish faster than
+	// TargetChunkLoadTime and shrinks multiplicatively when they are slower, staying within Min/Max bounds.
+	bool bUseAdaptiveChunkSize = false;
+	int32 MinAdaptiveChunkSize = 8;
+	int32 MaxAdaptiveChunkSize = 512;
+	float TargetChunkLoadTime = 0.1f;
+
+	// Full preload path list.
 	TArray<FSoftObjectPath> PreloadPaths;
 
+	// Cost weight per PreloadPaths entry. Empty when the selected collections have no generated weights.
+	TArray<int64> PreloadCostWeights;
+
+	// Priority tier per PreloadPaths entry, sorted critical first. Empty when every asset is in the normal tier.
+	TArray<ELPTAssetPriorityTier> PreloadTiers;
+
+	// True when PreloadPaths follow the cooked container order. Only then are chunks extended to whole packages.
+	bool bPreloadPathsInLoadOrder = false;
+
+	// Cost-weighted progress. TotalCostWeight is 0 when progress falls back to asset counts.
+	int64 TotalCostWeight = 0;
+	int64 LoadedCostWeight = 0;
+
+	// Cost weight of the contiguous completed range of PreloadPaths (chunked mode).
+	int64 CompletedCostWeight = 0;
+
+	// Indices of PreloadPaths not yet resident (aggregated mode). Scanned at most once per frame.
+	TArray<int32> PendingCostIndices;
+	uint64 LastCostScanFrame = 0;
+
 	// Current index in PreloadPaths for the next chunk.
 	int32 NextPreloadPathIndex = 0;
 
+	// Maximum number of chunk requests in flight at the same time.
+	int32 MaxChunksInFlight = 2;
+
+	// True while the chunked preload is owned by the global chunk scheduler.
+	bool bScheduled = false;
+
+	// Scheduler sequence number of the last chunk requested for this state. Used for fair-share ordering.
+	uint64 LastScheduledSequence = 0;
+
+	// Sliding window of requested chunks ordered by StartIndex. Completed chunks leave the window only
+	// once every earlier chunk has completed, so progress is always reported in request order.
+	TArray<FLevelPreloadChunkLPT> InFlightChunks;
+
+	// End of the contiguous range of PreloadPaths whose chunks have completed.
+	int32 CompletedPreloadPathIndex = 0;
+
+	// Time of the last chunk completion. Used to measure per-chunk load time when chunks overlap.
+	double LastChunkCompletionTime = 0.0;
+
+	// Time of the last adaptive chunk size decrease. Chunks requested before it were sized and queued under the old
+	// size, so their completions are not measured again.
+	double LastChunkDecreaseTime = 0.0;
+
+	// Guards against reporting completion twice when chunk callbacks arrive re-entrantly.
+	bool bPreloadCompleted = false;
+
+	// Full selected preload list before shared assets were split off. Becomes the resident preload set after level open.
+	TArray<FSoftObjectPath> SelectedPreloadPaths;
+
+	// Number of selected assets kept from the previous level instead of being requested.
+	int32 SharedAssetCount = 0;
+
+	// Cost weight of all selected assets. Used by the resident memory budget. Kept after a level instance is shown,
+	// the loaded level references its assets until it is unloaded.
+	int64 ResidentCostWeight = 0;
+
+	// Pinned preloads are never deferred by the resident memory budget.
+	bool bPinned = false;
+
+	// True while the preload waits in ULevelProgressTrackerSubsytem::BudgetDeferredPreloads.
+	bool bBudgetDeferred = false;
+
+	// Time of the load request.
+	double RequestTime = 0.0;
+
+	// Time the level open or level instance load was requested. 0 until then.
+	double LevelRequestTime = 0.0;
+
+	// Time of the last preload progress. Used by the watchdog to detect stalls.
+	double LastProgressTime = 0.0;
+
+	// True once the current stall was reported. Reset by the next progress.
+	bool bStallReported = false;
+
+	// Load session report data collected while the level loads. Finished once the level is loaded or cancelled.
+	FLPTLoadSessionReportData SessionReport;
+
+	// Latest preload progress. Read by GetLevelLoadProgressLPT and sent by coalesced progress broadcasts.
+	float Progress = 0.f;
+
+	// Progress coalescing. A pending update is sent by the subsystem tick once the frame or delta limit allows it.
+	float BroadcastProgress = 0.f;
+	uint64 LastBroadcastFrame = MAX_uint64;
+	bool bProgressBroadcastPending = false;
+
 	// Chunk handles retained until level open to keep preloaded assets referenced.
 	TArray<TSharedPtr<FStreamableHandle>> ChunkHandles;
+
+	// Assets carried over from a retargeted load. Held until selection so overlapping assets are not released in between.
+	TSharedPtr<FStreamableHandle> RetargetHandle;
+	TSet<FSoftObjectPath> RetargetPaths;
+
+	// True once the level open or level instance load was requested. The load can no longer be cancelled.
+	bool bLevelRequested = false;
+
+	// True once the load was cancelled. Late callbacks of a cancelled state are ignored.
+	bool bCancelled = false;
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "LPT Subsystem", meta = (ToolTip = "Total assets the target level contains."))
 	int32 TotalAssets = 0;
@@ -124,6 +376,30 @@ public:
 
 	// Runtime collection-selection options used to resolve preload assets from collection data assets.
 	FLPTLoadOptions LoadOptions;
+
+	// Returns preload progress in range 0..1. Uses loaded cost weight when available, asset counts otherwise.
+	float GetPreloadProgress() const
+	{
+		if (TotalCostWeight > 0)
+		{
+			return FMath::Clamp(static_cast<float>(static_cast<double>(LoadedCostWeight) / TotalCostWeight), 0.f, 1.f);
+		}
+
+		return TotalAssets > 0 ? FMath::Clamp(static_cast<float>(LoadedAssets) / TotalAssets, 0.f, 1.f) : 1.f;
+	}
+};
+
+// Preload held back by the resident memory budget until a running preload finishes.
+struct FBudgetDeferredPreloadLPT
+{
+	FName PackagePath;
+
+	bool bIsStreamingLevel = false;
+
+	TSharedPtr<FLevelState> LevelState;
+
+	// Selected paths without the shared assets kept from the previous level.
+	TArray<FSoftObjectPath> Paths;
 };
 
 /**
@@ -153,18 +429,36 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "LPT Subsystem")
 	FOnLevelLoadedLPT OnLevelLoadedLPT;
 
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLevelLoadProgressNativeLPT, FLPTLoadHandle, const FLPTLoadProgress&);
+	// Native counterpart of OnLevelLoadProgressLPT for C++ listeners. Sent with the same coalescing.
+	FOnLevelLoadProgressNativeLPT OnLevelLoadProgressNativeLPT;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnLevelLoadedNativeLPT, FLPTLoadHandle);
+	// Native counterpart of OnLevelLoadedLPT for C++ listeners.
+	FOnLevelLoadedNativeLPT OnLevelLoadedNativeLPT;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnLevelLoadFailedLPT, FLPTLoadHandle, LoadHandle, TSoftObjectPtr<UWorld>, LevelSoftPtr, FName, LevelName, const FString&, Reason);
+	// Sent when a level load is abandoned after a travel failure or the level open timeout. OnLevelLoadedLPT never follows.
+	UPROPERTY(BlueprintAssignable, Category = "LPT Subsystem")
+	FOnLevelLoadFailedLPT OnLevelLoadFailedLPT;
+
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLevelLoadFailedNativeLPT, FLPTLoadHandle, const FString&);
+	// Native counterpart of OnLevelLoadFailedLPT for C++ listeners.
+	FOnLevelLoadFailedNativeLPT OnLevelLoadFailedNativeLPT;
+
 #pragma endregion DELEGATES
 
 	/**
 	 * A function that opens a new level. Similar to the standard 'OpenLevel' function.
 	 * @param LevelSoftPtr Soft link to target level.
 	 * @param PreloadingResources Before opening a level, its resources are automatically loaded. If false, then the calculation of loaded assets and progress does not work.
-	 * @param LoadOptions Optional collection-selection options. Empty options use collection key "Default".
+	 * @param LoadOptions Optional collection-selection options. Empty options use collection keys "Default" and "Learned".
+	 * @return Handle of the load request. Invalid if the request was rejected.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "LPT Subsystem", meta = (AutoCreateRefTerm = "LoadOptions"))
-	void OpenLevelLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources, const FLPTLoadOptions& LoadOptions);
+	FLPTLoadHandle OpenLevelLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources, const FLPTLoadOptions& LoadOptions);
 
-	void OpenLevelLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources = true);
+	FLPTLoadHandle OpenLevelLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, bool PreloadingResources = true);
 
 	/**
 	 * Function that causes an asynchronous loading of an embedded level into the current game level. 
@@ -174,10 +468,11 @@ public:
 	 * @param OptionalLevelStreamingClass Allows you to specify a custom class instead of the standard one.
 	 * @param bLoadAsTempPackage If this is true, the level is loaded as a temporary package that is not saved to disk.
 	 * @param PreloadingResources Before opening a level, its resources are automatically loaded. If False, then the calculation of loaded assets and progress does not work.
-	 * @param LoadOptions Optional collection-selection options. Empty options use collection key "Default".
+	 * @param LoadOptions Optional collection-selection options. Empty options use collection keys "Default" and "Learned".
+	 * @return Handle of the load request. Invalid if the request was rejected.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "LPT Subsystem", meta = (AutoCreateRefTerm = "LoadOptions"))
-	void LoadLevelInstanceLPT(
+	FLPTLoadHandle LoadLevelInstanceLPT(
 		TSoftObjectPtr<UWorld> LevelSoftPtr,
 		const FTransform Transform,
 		TSubclassOf<ULevelStreamingDynamic> OptionalLevelStreamingClass,
@@ -186,7 +481,7 @@ public:
 		const FLPTLoadOptions& LoadOptions
 	);
 
-	void LoadLevelInstanceLPT(
+	FLPTLoadHandle LoadLevelInstanceLPT(
 		TSoftObjectPtr<UWorld> LevelSoftPtr,
 		const FTransform Transform,
 		TSubclassOf<ULevelStreamingDynamic> OptionalLevelStreamingClass = nullptr,
@@ -194,6 +489,27 @@ public:
 		bool PreloadingResources = true
 	);
 
+	/**
+	 * Cancels an in-flight level load. Outstanding preload requests are cancelled and queued chunks are not requested.
+	 * Has no effect once the level itself was requested.
+	 * @param LevelSoftPtr Soft link to the level being loaded.
+	 * @return True if a load was cancelled.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "LPT Subsystem")
+	bool CancelLevelLoadLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr);
+
+	/**
+	 * Cancels an in-flight level load and starts loading another level with the same load method.
+	 * Already loaded assets that the new level also preloads are kept in memory.
+	 * @param LevelSoftPtr Soft link to the level being loaded.
+	 * @param NewLevelSoftPtr Soft link to the new target level.
+	 * @param PreloadingResources Before opening the new level, its resources are automatically loaded.
+	 * @param LoadOptions Optional collection-selection options for the new level. Empty options use collection keys "Default" and "Learned".
+	 * @return Handle of the new load request. Invalid if the load was not retargeted.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "LPT Subsystem", meta = (AutoCreateRefTerm = "LoadOptions"))
+	FLPTLoadHandle RetargetLevelLoadLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, const TSoftObjectPtr<UWorld> NewLevelSoftPtr, bool PreloadingResources, const FLPTLoadOptions& LoadOptions);
+
 	/**
 	 * Unloads the streaming level and breaks the reference to cached resources in memory, 
 	 * handing over memory control to the standard Unreal Enigne system.
@@ -221,6 +537,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "LPT Subsystem")
 	void RemoveSlateWidgetLPT();
 
+	// Returns true if the preload database is loaded and level transitions can start preloading without waiting for it.
+	UFUNCTION(BlueprintPure, Category = "LPT Subsystem")
+	bool IsPreloadDatabaseReadyLPT() const;
+
+	/**
+	 * Returns cached preload progress of a level that is being loaded, in range 0..1. Cheap enough to poll every frame.
+	 * @param LevelSoftPtr Soft link to target level.
+	 * @param LoadedAssets Number of loaded preload assets.
+	 * @param TotalAssets Number of preload assets.
+	 * @return Progress of the level, 0 if the level is not being loaded.
+	 */
+	UFUNCTION(BlueprintPure, Category = "LPT Subsystem")
+	float GetLevelLoadProgressLPT(const TSoftObjectPtr<UWorld> LevelSoftPtr, int32& LoadedAssets, int32& TotalAssets) const;
+
+	// Returns the report of the last finished level load session, or null if no load has finished yet.
+	UFUNCTION(BlueprintPure, Category = "LPT Subsystem")
+	ULPTLoadSessionReport* GetLastLoadSessionReportLPT() const;
+
 	// Returns true if the launch took place in the editor or false if the launch was not from the editor.
 	UFUNCTION(BlueprintPure, Category = "LPT Subsystem")
 	bool CheckingPIE();
@@ -239,6 +573,159 @@ private:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "LPT Subsystem", meta = (AllowPrivateAccess = "true", ToolTip = "Database generated in editor with assets that should be preloaded for each level."))
 	TSoftObjectPtr<ULevelPreloadDatabaseLPT> PreloadDatabaseAsset;
 
+	// Handle of the async database load. Kept for the subsystem lifetime when the database is pinned.
+	TSharedPtr<FStreamableHandle> PreloadDatabaseHandle;
+
+	// Preload set of the current map. Used to find assets shared with the next level.
+	TSet<FSoftObjectPath> ResidentPreloadPaths;
+
+	// Levels whose preload was requested before the database finished loading. Resumed in OnPreloadDatabaseLoaded.
+	TArray<FName> PendingDatabaseLevels;
+
+	// Global chunk scheduler state. A pass requested while one is running is repeated instead of nested.
+	bool bIsSchedulingPreloadChunks = false;
+	bool bPreloadScheduleDirty = false;
+	uint64 PreloadScheduleSequence = 0;
+
+	// Last issued load handle ID.
+	int32 LastLoadHandleId = 0;
+
+	// Assets of a cancelled load handed to the next level state created by RetargetLevelLoadLPT.
+	TSharedPtr<FStreamableHandle> RetargetCarryHandle;
+	TSet<FSoftObjectPath> RetargetCarryPaths;
+
+	// Core ticker used for idle-time work.
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	// Active speculative prefetch.
+	FLevelPrefetchLPT PrefetchState;
+
+	// Preloads deferred by the resident memory budget, in request order.
+	TArray<FBudgetDeferredPreloadLPT> BudgetDeferredPreloads;
+
+	// Level package for which a prefetch decision was already made. Reset when a new map is loaded.
+	FName PrefetchSourcePackage;
+
+	// Accumulated idle time on the current map.
+	float PrefetchIdleTime = 0.f;
+
+	// Learned transition graph: source level package -> target level package -> transition count.
+	TMap<FName, TMap<FName, int32>> LearnedTransitions;
+
+	bool bLearnedTransitionsDirty = false;
+
+	// Record mode state. RecordLevelPackage is None when no recording is active.
+	FName RecordLevelPackage;
+	float RecordTimeLeft = 0.f;
+	TSet<FName> RecordPreloadedPackages;
+	TSet<FSoftObjectPath> RecordedMissingAssets;
+	FDelegateHandle RecordEndLoadPackageHandle;
+
+	// Overfetch analysis state. OverfetchLevelPackage is None when no analysis is pending.
+	FName OverfetchLevelPackage;
+	float OverfetchTimeLeft = 0.f;
+	TArray<FSoftObjectPath> OverfetchCollectionPaths;
+	TSharedPtr<FStreamableHandle> OverfetchCollectionsHandle;
+	FDelegateHandle OverfetchPostGarbageCollectHandle;
+	bool bOverfetchGarbageCollected = false;
+
+	// Watchdog delegate handles.
+	FDelegateHandle TravelFailureHandle;
+	FDelegateHandle SyncLoadPackageHandle;
+	FDelegateHandle AsyncLoadingFlushHandle;
+
+	// Report of the last finished level load session.
+	UPROPERTY()
+	TObjectPtr<ULPTLoadSessionReport> LastLoadSessionReport;
+
+	// Subsystem tick on the core ticker.
+	bool TickLPT(float DeltaTime);
+
+	// Samples per-frame LPT stat and CSV gauges.
+	void UpdateRuntimeStats() const;
+
+	// Starts prefetch of the likely next level once the game has been idle long enough.
+	void TickSpeculativePrefetch(float DeltaTime);
+
+	// Returns the most likely next level for the source level from the authored and learned graph. Returns false if none.
+	bool FindLikelyNextLevel(FName SourcePackage, TSoftObjectPtr<UWorld>& OutLevelSoftPtr) const;
+
+	// Requests the default collection of the level entry at low priority.
+	void StartSpeculativePrefetch(const TSoftObjectPtr<UWorld>& LevelSoftPtr);
+
+	// Callback when prefetch collections are loaded. Requests collection assets within the memory cap.
+	void OnPrefetchCollectionsLoaded(FName PackagePath);
+
+	// Cancels and releases the active prefetch.
+	void CancelSpeculativePrefetch();
+
+	// Moves prefetched handles of the level to the level state. Returns true if a prefetch was adopted.
+	bool AdoptSpeculativePrefetch(FName PackagePath, TSharedRef<FLevelState> LevelState);
+
+	// Records a transition from the current map to the target level in the learned graph.
+	void RecordLevelTransition(FName TargetPackage);
+
+	void LoadLearnedTransitions();
+	void SaveLearnedTransitions();
+
+	// Starts recording packages loaded on the opened level that are not in its preload set (record mode, development builds only).
+	void StartMissingAssetRecording(FName LevelPackage);
+
+	// Stops the active recording and merges recorded assets into the learned assets file of the level.
+	void StopMissingAssetRecording();
+
+	// Stops the recording once the record window has elapsed.
+	void TickMissingAssetRecording(float DeltaTime);
+
+	// Adds the assets of loaded packages that were not preloaded to the recording.
+	void OnRecordEndLoadPackage(const FEndLoadPackageContext& Context);
+
+	// Schedules the overfetch analysis of the opened level's preload set (development builds only).
+	void StartOverfetchAnalysis(FName LevelPackage, const TArray<FString>& CollectionPaths);
+
+	// Cancels the pending overfetch analysis.
+	void CancelOverfetchAnalysis();
+
+	// Loads the analyzed collections after the delay, forces a full GC and evaluates once it has run.
+	void TickOverfetchAnalysis(float DeltaTime);
+
+	// Callback when analyzed collections are loaded. Cancels the speculative prefetch and forces a full garbage collection.
+	void OnOverfetchCollectionsLoaded();
+
+	// Writes the per-collection report of preloaded assets that are no longer alive.
+	void EvaluatePreloadOverfetch();
+
+	// Reports stalled preloads and releases level states whose level never finished loading.
+	void TickLoadWatchdog();
+
+	// Logs the assets of the level state that are still pending.
+	void ReportPreloadStall(const TSharedRef<FLevelState>& LevelState, double StallTime);
+
+	// Releases a level state whose level open failed or timed out and sends OnLevelLoadFailedLPT.
+	void AbandonLevelState(FName PackagePath, TSharedRef<FLevelState> LevelState, const FString& Reason);
+
+	// Releases the level state of a failed OpenLevelLPT transition.
+	void OnTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
+
+	// Flags synchronous loads and async loading flushes that happen while an LPT preload is active (development builds only).
+	void OnSyncLoadPackage(const FString& PackageName);
+	void OnAsyncLoadingFlush();
+
+	// Adds preload paths of the level state that are not resident after the preload completed to the session report.
+	void CollectFailedPreloadPaths(TSharedRef<FLevelState> LevelState);
+
+	// Finishes the session report of the level state, stores it as the last report and writes it to Saved/LPT/Sessions.
+	void FinishLoadSessionReport(TSharedRef<FLevelState> LevelState);
+
+	// Returns the package name of the current world without PIE prefix.
+	FName GetCurrentWorldPackageName() const;
+
+	// Starts the async load of the preload database if it is not loaded or already being loaded.
+	void RequestPreloadDatabaseLoad();
+
+	// Callback when the async database load is complete. Resumes queued level preloads.
+	void OnPreloadDatabaseLoaded();
+
 	/**
 	 * Starts async preloading by reading the entry for the level from preload database.
 	 * @param LevelSoftPtr Soft link to target level.
@@ -247,27 +734,89 @@ private:
 	 * @param LevelInstanceState If the level is streaming, then parameters for function 'LoadLevelInstanceBySoftObjectPtr()' are passed to it.
 	 */
 	UFUNCTION()
-	void AsyncLoadAssetsLPT(
+	FLPTLoadHandle AsyncLoadAssetsLPT(
 		const TSoftObjectPtr<UWorld> LevelSoftPtr,
 		bool PreloadingResources,
 		bool bIsStreamingLevel,
 		FLevelInstanceState LevelInstanceState,
 		const FLPTLoadOptions& LoadOptions);
 
+	// Callback when collection and filter settings assets of the level entry are loaded. Selects collections and starts the asset preload.
+	void OnPreloadCollectionsLoaded(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState);
+
+	// Releases the handle that keeps collection and filter settings assets loaded during selection.
+	void ReleaseMetadataHandle(TSharedRef<FLevelState> LevelState);
+
+	// Cancels outstanding requests of the level state and removes it from LevelLoadedMap.
+	void CancelLevelState(FName PackagePath, TSharedRef<FLevelState> LevelState);
+
+	// Keeps assets carried over from a retargeted load that are also selected for this level, and drops the rest.
+	void AdoptRetargetedAssets(TSharedRef<FLevelState> LevelState);
+
+	/**
+	 * Removes assets that are shared with the resident preload set of the current map from the preload list and
+	 * keeps them referenced by the level state across OpenLevel, so only the difference is requested.
+	 */
+	void KeepSharedPreloadAssets(TSharedRef<FLevelState> LevelState, TArray<FSoftObjectPath>& InOutPaths, TArray<int64>& InOutCostWeights, TArray<ELPTAssetPriorityTier>& InOutTiers);
+
+	// Reports full progress and opens the level without preloading resources.
+	void StartLevelWithoutPreload(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState);
+
 	// Callback when all loads are complete.
 	void OnAllAssetsLoaded(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState);
 
+	// Requests the packages of the preload paths with LoadPackageAsync, all at once with tier priorities.
+	void StartPackagePreload(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, const TArray<FSoftObjectPath>& Paths);
+
+	// Aggregated preload with priority tiers. Requests every tier at once at its own priority and returns a handle
+	// combining them, which completes when all tiers have loaded. Returns nullptr when no tier request was created.
+	TSharedPtr<FStreamableHandle> RequestTieredAggregatedPreload(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, const TArray<FSoftObjectPath>& Paths);
+
+	// Completion of one package of a package-granular preload. Progress advances per package.
+	void OnPreloadPackageLoaded(const FName& LoadedPackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result, FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, TWeakPtr<FPackagePreloadLPT> WeakPackagePreload, int32 PackageIndex);
+
 	// Callback when one chunk load is complete.
-	void OnPreloadChunkLoaded(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, int32 LoadedChunkAssetCount);
+	void OnPreloadChunkLoaded(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, int32 ChunkStartIndex);
+
+	/**
+	 * Marks a chunk of the in-flight window as completed and advances the in-order progress.
+	 * @param bLoaded False for a chunk whose request failed. It is not measured for adaptive sizing.
+	 * @return True if LoadedAssets advanced.
+	 */
+	bool MarkPreloadChunkCompleted(TSharedRef<FLevelState> LevelState, int32 ChunkStartIndex, bool bLoaded = true);
+
+	// Adjusts the next chunk size from the measured duration of a completed chunk (adaptive mode only).
+	void UpdateAdaptiveChunkSize(TSharedRef<FLevelState> LevelState, int32 LoadedChunkAssetCount, double ChunkLoadTime, double ChunkRequestTime);
 
 	// Сallback when the global level is fully loaded.
 	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
 
+	/**
+	 * Caches progress of the level state and broadcasts OnLevelLoadProgressLPT at most once per frame and only after
+	 * MinProgressBroadcastDelta. Skipped updates are sent by FlushPendingProgressBroadcasts. Forced broadcasts are always sent.
+	 */
+	void BroadcastLevelLoadProgress(TSharedRef<FLevelState> LevelState, float Progress, bool bForce = false);
+
+	// Sends progress updates that were coalesced in a previous frame.
+	void FlushPendingProgressBroadcasts();
+
 	// Callback when loading each asset.
 	void HandleAssetLoaded(TSharedRef<FStreamableHandle> Handle, FName PackagePath, TSharedRef<FLevelState> LevelState);
 
-	// Callback when loading chunk assets.
-	void HandleChunkAssetLoaded(TSharedRef<FStreamableHandle> Handle, FName PackagePath, TSharedRef<FLevelState> LevelState, int32 ChunkBaseLoaded, int32 ChunkAssetCount);
+	// Callback when loading chunk assets. Only the oldest in-flight chunk contributes partial progress.
+	void HandleChunkAssetLoaded(TSharedRef<FStreamableHandle> Handle, FName PackagePath, TSharedRef<FLevelState> LevelState, int32 ChunkStartIndex, int32 ChunkAssetCount);
+
+	/**
+	 * Fits the incoming preload into ResidentMemoryBudgetMB. Releases the speculative prefetch first. Returns false when
+	 * the preload has to wait for running preloads, level states are never released.
+	 */
+	bool EnforceResidentMemoryBudget(TSharedRef<FLevelState> IncomingState, int64 IncomingCostWeight);
+
+	// Starts deferred preloads in request order once they fit the budget or nothing is left to wait for.
+	void StartBudgetDeferredPreloads();
+
+	// Requests the selected preload paths with the preload mode of the level state.
+	void RequestSelectedPreload(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState, TArray<FSoftObjectPath> Paths);
 
 	// Releases all streamable handles associated with a level state.
 	void ReleaseLevelStateHandles(TSharedRef<FLevelState> LevelState, bool bCancelHandles);
@@ -276,7 +825,8 @@ private:
 	void StartLevelLPT(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState);
 
 	/**
-	 * Loads precomputed asset paths for the target level from preload database and starts async loading.
+	 * Resolves the preload database entry for the target level and asynchronously loads its collection assets.
+	 * Selection and asset preloading continue in OnPreloadCollectionsLoaded.
 	 * @param PackagePath The name of the level package (FName) for which we are looking for resources.
 	 * @param LevelSoftPtr Soft pointer to level used to resolve corresponding preload entry.
 	 * @param LevelState A shared FLevelState structure that stores progress, pointers, and streaming parameters.
@@ -284,9 +834,18 @@ private:
 	 */
 	void StartPreloadingResources(FName PackagePath, const TSoftObjectPtr<UWorld>& LevelSoftPtr, TSharedRef<FLevelState>& LevelState, bool bIsStreamingLevel, const FLPTLoadOptions& LoadOptions);
 
-	// Starts loading the next chunk for chunked preload mode.
+	// Hands the chunked preload of the level state to the global chunk scheduler.
 	void StartNextPreloadChunk(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState);
 
+	/**
+	 * Global chunk scheduler. Fills free slots of MaxGlobalChunksInFlight with chunk requests of all active level states,
+	 * foreground OpenLevel loads first, then fair share between level instance loads. Finishes states whose chunks are all done.
+	 */
+	void SchedulePreloadChunks();
+
+	// Requests a single chunk starting at NextPreloadPathIndex and adds it to the in-flight window.
+	void RequestPreloadChunk(FName PackagePath, bool bIsStreamingLevel, TSharedRef<FLevelState> LevelState);
+
 	// Call after loading the streaming level
 	UFUNCTION()
 	void OnLevelShown();
@@ -22,6 +22,7 @@ public class LevelProgressTrackerEditor : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"GameplayTags",
+				"Json",
 				"UnrealEd",
 				"AssetRegistry",
 				"Slate",
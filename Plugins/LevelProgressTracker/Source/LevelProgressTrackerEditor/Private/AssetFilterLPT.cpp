@@ -69,6 +69,69 @@ namespace AssetFilterLPT
 
 			return AssetClassPath.ToString().StartsWith(TEXT("/Script/Engine.Texture"));
 		}
+
+		enum class EAssetClassCategoryLPT : uint8
+		{
+			None,
+			StaticMesh,
+			SkeletalMesh,
+			Material,
+			Niagara,
+			Sound,
+			Widget,
+			DataAsset
+		};
+
+		EAssetClassCategoryLPT GetAssetClassCategory(const FAssetData& AssetData)
+		{
+			if (UClass* AssetClass = AssetData.GetClass(EResolveClass::Yes))
+			{
+				if (AssetClass->IsChildOf(UStaticMesh::StaticClass()))
+				{
+					return EAssetClassCategoryLPT::StaticMesh;
+				}
+
+				if (AssetClass->IsChildOf(USkeletalMesh::StaticClass()))
+				{
+					return EAssetClassCategoryLPT::SkeletalMesh;
+				}
+
+				if (AssetClass->IsChildOf(UMaterialInterface::StaticClass()) ||
+					AssetClass->IsChildOf(UMaterialFunctionInterface::StaticClass()) ||
+					AssetClass->IsChildOf(UMaterialParameterCollection::StaticClass()) ||
+					AssetClass->IsChildOf(UTexture::StaticClass()))
+				{
+					return EAssetClassCategoryLPT::Material;
+				}
+
+				if (AssetClass->IsChildOf(USoundBase::StaticClass()))
+				{
+					return EAssetClassCategoryLPT::Sound;
+				}
+
+				if (AssetClass->IsChildOf(UDataAsset::StaticClass()))
+				{
+					return EAssetClassCategoryLPT::DataAsset;
+				}
+			}
+
+			if (IsNiagaraAssetClass(AssetData.AssetClassPath))
+			{
+				return EAssetClassCategoryLPT::Niagara;
+			}
+
+			if (IsWidgetAssetClass(AssetData.AssetClassPath))
+			{
+				return EAssetClassCategoryLPT::Widget;
+			}
+
+			if (IsMaterialRelatedAssetClass(AssetData.AssetClassPath))
+			{
+				return EAssetClassCategoryLPT::Material;
+			}
+
+			return EAssetClassCategoryLPT::None;
+		}
 	}
 
 	bool ShouldIncludeAssetByClass(const FAssetData& AssetData, const FLPTFilterSettings* Rules)
@@ -84,73 +147,60 @@ namespace AssetFilterLPT
 			return true;
 		}
 
-		bool bMatchesTrackedCategory = false;
-		bool bAllowed = true;
-
-		if (UClass* AssetClass = AssetData.GetClass(EResolveClass::Yes))
+		// When class filter is customized, treat it as a strict allow-list.
+		switch (GetAssetClassCategory(AssetData))
 		{
-			if (AssetClass->IsChildOf(UStaticMesh::StaticClass()))
-			{
-				bMatchesTrackedCategory = true;
-				bAllowed = ClassFilter.bIncludeStaticMeshes;
-			}
-			else if (AssetClass->IsChildOf(USkeletalMesh::StaticClass()))
-			{
-				bMatchesTrackedCategory = true;
-				bAllowed = ClassFilter.bIncludeSkeletalMeshes;
-			}
-			else if (AssetClass->IsChildOf(UMaterialInterface::StaticClass()))
-			{
-				bMatchesTrackedCategory = true;
-				bAllowed = ClassFilter.bIncludeMaterials;
-			}
-			else if (AssetClass->IsChildOf(UMaterialFunctionInterface::StaticClass()))
-			{
-				bMatchesTrackedCategory = true;
-				bAllowed = ClassFilter.bIncludeMaterials;
-			}
-			else if (AssetClass->IsChildOf(UMaterialParameterCollection::StaticClass()))
-			{
-				bMatchesTrackedCategory = true;
-				bAllowed = ClassFilter.bIncludeMaterials;
-			}
-			else if (AssetClass->IsChildOf(UTexture::StaticClass()))
-			{
-				bMatchesTrackedCategory = true;
-				bAllowed = ClassFilter.bIncludeMaterials;
-			}
-			else if (AssetClass->IsChildOf(USoundBase::StaticClass()))
-			{
-				bMatchesTrackedCategory = true;
-				bAllowed = ClassFilter.bIncludeSounds;
-			}
-			else if (AssetClass->IsChildOf(UDataAsset::StaticClass()))
-			{
-				bMatchesTrackedCategory = true;
-				bAllowed = ClassFilter.bIncludeDataAssets;
-			}
+		case EAssetClassCategoryLPT::StaticMesh:
+			return ClassFilter.bIncludeStaticMeshes;
+		case EAssetClassCategoryLPT::SkeletalMesh:
+			return ClassFilter.bIncludeSkeletalMeshes;
+		case EAssetClassCategoryLPT::Material:
+			return ClassFilter.bIncludeMaterials;
+		case EAssetClassCategoryLPT::Niagara:
+			return ClassFilter.bIncludeNiagara;
+		case EAssetClassCategoryLPT::Sound:
+			return ClassFilter.bIncludeSounds;
+		case EAssetClassCategoryLPT::Widget:
+			return ClassFilter.bIncludeWidgets;
+		case EAssetClassCategoryLPT::DataAsset:
+			return ClassFilter.bIncludeDataAssets;
+		default:
+			return false;
 		}
+	}
 
-		if (!bMatchesTrackedCategory && IsNiagaraAssetClass(AssetData.AssetClassPath))
+	ELPTAssetPriorityTier ResolveAssetPriorityTier(const FAssetData& AssetData, const FLPTAssetTierRules& TierRules)
+	{
+		const FSoftObjectPath AssetPath = AssetData.GetSoftObjectPath();
+		if (TierRules.CriticalAssets.Contains(AssetPath))
 		{
-			bMatchesTrackedCategory = true;
-			bAllowed = ClassFilter.bIncludeNiagara;
+			return ELPTAssetPriorityTier::Critical;
 		}
 
-		if (!bMatchesTrackedCategory && IsWidgetAssetClass(AssetData.AssetClassPath))
+		if (TierRules.DeferredAssets.Contains(AssetPath))
 		{
-			bMatchesTrackedCategory = true;
-			bAllowed = ClassFilter.bIncludeWidgets;
+			return ELPTAssetPriorityTier::Deferred;
 		}
 
-		if (!bMatchesTrackedCategory && IsMaterialRelatedAssetClass(AssetData.AssetClassPath))
+		switch (GetAssetClassCategory(AssetData))
 		{
-			bMatchesTrackedCategory = true;
-			bAllowed = ClassFilter.bIncludeMaterials;
+		case EAssetClassCategoryLPT::StaticMesh:
+			return TierRules.StaticMeshTier;
+		case EAssetClassCategoryLPT::SkeletalMesh:
+			return TierRules.SkeletalMeshTier;
+		case EAssetClassCategoryLPT::Material:
+			return TierRules.MaterialTier;
+		case EAssetClassCategoryLPT::Niagara:
+			return TierRules.NiagaraTier;
+		case EAssetClassCategoryLPT::Sound:
+			return TierRules.SoundTier;
+		case EAssetClassCategoryLPT::Widget:
+			return TierRules.WidgetTier;
+		case EAssetClassCategoryLPT::DataAsset:
+			return TierRules.DataAssetTier;
+		default:
+			return TierRules.OtherTier;
 		}
-
-		// When class filter is customized, treat it as a strict allow-list.
-		return bMatchesTrackedCategory ? bAllowed : false;
 	}
 
 	TArray<FSoftObjectPath> MergeSoftObjectPaths(
@@ -313,6 +363,9 @@ namespace AssetFilterLPT
 		Merged.bUseChunkedPreload = GlobalRules.bUseChunkedPreload;
 		Merged.PreloadChunkSize = FMath::Max(1, GlobalRules.PreloadChunkSize);
 		Merged.AssetClassFilter = GlobalRules.AssetClassFilter;
+		Merged.AssetTierRules = GlobalRules.AssetTierRules;
+		Merged.AssetTierRules.CriticalAssets = MergeSoftObjectPaths(LevelRules.AssetTierRules.CriticalAssets, GlobalRules.AssetTierRules.CriticalAssets);
+		Merged.AssetTierRules.DeferredAssets = MergeSoftObjectPaths(LevelRules.AssetTierRules.DeferredAssets, GlobalRules.AssetTierRules.DeferredAssets);
 		Merged.WorldPartitionDataLayerAssets = MergeDataLayerAssetRules(LevelRules.WorldPartitionDataLayerAssets, GlobalRules.WorldPartitionDataLayerAssets);
 		Merged.WorldPartitionRegions = MergeNameRules(LevelRules.WorldPartitionRegions, GlobalRules.WorldPartitionRegions);
 		Merged.WorldPartitionCells = MergeStringRules(LevelRules.WorldPartitionCells, GlobalRules.WorldPartitionCells);
@@ -12,6 +12,7 @@ class ULevelProgressTrackerSettings;
 namespace AssetFilterLPT
 {
 	bool ShouldIncludeAssetByClass(const FAssetData& AssetData, const FLPTFilterSettings* Rules);
+	ELPTAssetPriorityTier ResolveAssetPriorityTier(const FAssetData& AssetData, const FLPTAssetTierRules& TierRules);
 
 	TArray<FSoftObjectPath> MergeSoftObjectPaths(
 		const TArray<FSoftObjectPath>& LevelPaths,
@@ -0,0 +1,196 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "BenchmarkContentLPT.h"
+
+#include "LogLPTEditor.h"
+#include "SettingsLPT.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace BenchmarkContentLPT
+{
+	namespace
+	{
+		const TCHAR* BenchmarkRootPath = TEXT("/LevelProgressTracker/Benchmark");
+
+		// Level name and number of unique mesh and material pairs placed in it.
+		struct FBenchmarkLevelSpec
+		{
+			const TCHAR* LevelName;
+			int32 AssetCount;
+		};
+
+		constexpr FBenchmarkLevelSpec BenchmarkLevels[] = {
+			{ TEXT("LPT_Bench_Small"), 64 },
+			{ TEXT("LPT_Bench_Medium"), 256 },
+			{ TEXT("LPT_Bench_Large"), 1024 }
+		};
+
+		const TCHAR* SourceMeshPaths[] = {
+			TEXT("/Engine/BasicShapes/Cube.Cube"),
+			TEXT("/Engine/BasicShapes/Sphere.Sphere"),
+			TEXT("/Engine/BasicShapes/Cylinder.Cylinder"),
+			TEXT("/Engine/BasicShapes/Cone.Cone")
+		};
+
+		const TCHAR* ParentMaterialPath = TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial");
+
+		// Distance between placed actors.
+		constexpr float ActorSpacing = 300.f;
+
+		bool SavePackageFile(UPackage* Package, UObject* AssetObject, const FString& PackageExtension)
+		{
+			FString PackageFilename;
+			if (!FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), PackageFilename, PackageExtension))
+			{
+				return false;
+			}
+
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(PackageFilename), true);
+
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+			SaveArgs.SaveFlags = SAVE_NoError;
+			SaveArgs.Error = GError;
+			if (!UPackage::SavePackage(Package, AssetObject, *PackageFilename, SaveArgs))
+			{
+				return false;
+			}
+
+			// Collections are generated from the registry dependencies of the saved level.
+			IAssetRegistry::GetChecked().ScanFilesSynchronous({ PackageFilename }, true);
+			return true;
+		}
+
+		UStaticMesh* CreateBenchmarkMesh(const FString& AssetFolder, const FString& AssetName, const UStaticMesh* SourceMesh)
+		{
+			UPackage* Package = CreatePackage(*FString::Printf(TEXT("%s/%s"), *AssetFolder, *AssetName));
+			UStaticMesh* Mesh = DuplicateObject<UStaticMesh>(SourceMesh, Package, FName(*AssetName));
+			if (!Mesh)
+			{
+				return nullptr;
+			}
+
+			Mesh->SetFlags(RF_Public | RF_Standalone);
+			return SavePackageFile(Package, Mesh, FPackageName::GetAssetPackageExtension()) ? Mesh : nullptr;
+		}
+
+		UMaterialInstanceConstant* CreateBenchmarkMaterial(const FString& AssetFolder, const FString& AssetName, UMaterialInterface* ParentMaterial, const FLinearColor& Color)
+		{
+			UPackage* Package = CreatePackage(*FString::Printf(TEXT("%s/%s"), *AssetFolder, *AssetName));
+			UMaterialInstanceConstant* Material = NewObject<UMaterialInstanceConstant>(Package, FName(*AssetName), RF_Public | RF_Standalone);
+			Material->SetParentEditorOnly(ParentMaterial);
+			Material->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(TEXT("Color")), Color);
+			Material->PostEditChange();
+
+			return SavePackageFile(Package, Material, FPackageName::GetAssetPackageExtension()) ? Material : nullptr;
+		}
+
+		bool GenerateBenchmarkLevel(const FBenchmarkLevelSpec& LevelSpec, TFunctionRef<void(UWorld*)> OnLevelSaved)
+		{
+			const FString LevelPackagePath = FString::Printf(TEXT("%s/Maps/%s"), BenchmarkRootPath, LevelSpec.LevelName);
+			if (FPackageName::DoesPackageExist(LevelPackagePath))
+			{
+				UE_LOG(LogLPTEditor, Log, TEXT("Benchmark level '%s' already exists. Delete it to generate it again."), *LevelPackagePath);
+				return false;
+			}
+
+			UMaterialInterface* ParentMaterial = LoadObject<UMaterialInterface>(nullptr, ParentMaterialPath);
+			TArray<UStaticMesh*> SourceMeshes;
+			for (const TCHAR* SourceMeshPath : SourceMeshPaths)
+			{
+				if (UStaticMesh* SourceMesh = LoadObject<UStaticMesh>(nullptr, SourceMeshPath))
+				{
+					SourceMeshes.Add(SourceMesh);
+				}
+			}
+
+			if (!ParentMaterial || SourceMeshes.IsEmpty())
+			{
+				UE_LOG(LogLPTEditor, Warning, TEXT("Engine basic shapes are not available. Benchmark level '%s' was not generated."), *LevelPackagePath);
+				return false;
+			}
+
+			UPackage* LevelPackage = CreatePackage(*LevelPackagePath);
+			UWorld* World = UWorld::CreateWorld(EWorldType::Inactive, false, FName(LevelSpec.LevelName), LevelPackage);
+			if (!World)
+			{
+				return false;
+			}
+
+			World->SetFlags(RF_Public | RF_Standalone);
+
+			const FString AssetFolder = FString::Printf(TEXT("%s/Assets/%s"), BenchmarkRootPath, LevelSpec.LevelName);
+			const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(LevelSpec.AssetCount)));
+			bool bAssetsSaved = true;
+			for (int32 AssetIndex = 0; AssetIndex < LevelSpec.AssetCount && bAssetsSaved; ++AssetIndex)
+			{
+				UStaticMesh* Mesh = CreateBenchmarkMesh(AssetFolder, FString::Printf(TEXT("SM_%s_%d"), LevelSpec.LevelName, AssetIndex), SourceMeshes[AssetIndex % SourceMeshes.Num()]);
+				UMaterialInstanceConstant* Material = CreateBenchmarkMaterial(
+					AssetFolder,
+					FString::Printf(TEXT("MI_%s_%d"), LevelSpec.LevelName, AssetIndex),
+					ParentMaterial,
+					FLinearColor::MakeFromHSV8(static_cast<uint8>(AssetIndex * 37), 200, 255)
+				);
+				bAssetsSaved = Mesh && Material;
+				if (!bAssetsSaved)
+				{
+					break;
+				}
+
+				const FVector Location((AssetIndex % GridSize) * ActorSpacing, (AssetIndex / GridSize) * ActorSpacing, 0.f);
+				AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+				Actor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+				Actor->GetStaticMeshComponent()->SetMaterial(0, Material);
+			}
+
+			const bool bLevelSaved = bAssetsSaved && SavePackageFile(LevelPackage, World, FPackageName::GetMapPackageExtension());
+			if (bLevelSaved)
+			{
+				OnLevelSaved(World);
+			}
+			else
+			{
+				UE_LOG(LogLPTEditor, Warning, TEXT("Failed to save benchmark level '%s'."), *LevelPackagePath);
+			}
+
+			World->DestroyWorld(false);
+			World->RemoveFromRoot();
+			return bLevelSaved;
+		}
+	}
+
+	ULevelProgressTrackerSettings* CreateBenchmarkSettings()
+	{
+		// New settings objects start from the project settings.
+		ULevelProgressTrackerSettings* Settings = NewObject<ULevelProgressTrackerSettings>(GetTransientPackage());
+		Settings->AssetCollectionFolder.Path = FString::Printf(TEXT("%s/Collections"), BenchmarkRootPath);
+		Settings->AssetFilterSettingsFolder.Path = FString::Printf(TEXT("%s/FilterSettings"), BenchmarkRootPath);
+		return Settings;
+	}
+
+	int32 GenerateBenchmarkLevels(TFunctionRef<void(UWorld*)> OnLevelSaved)
+	{
+		int32 GeneratedLevelCount = 0;
+		for (const FBenchmarkLevelSpec& LevelSpec : BenchmarkLevels)
+		{
+			if (GenerateBenchmarkLevel(LevelSpec, OnLevelSaved))
+			{
+				++GeneratedLevelCount;
+			}
+		}
+
+		return GeneratedLevelCount;
+	}
+}
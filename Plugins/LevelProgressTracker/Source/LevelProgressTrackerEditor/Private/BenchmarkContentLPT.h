@@ -0,0 +1,25 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+class ULevelProgressTrackerSettings;
+
+/**
+ * Generates the levels used by the LPT.Benchmark automation test under /LevelProgressTracker/Benchmark.
+ * Every level places its own static meshes and material instances, so a cold load preloads a known set of assets.
+ */
+namespace BenchmarkContentLPT
+{
+	// Project settings copy that stores collections and filter settings of benchmark levels in the plugin folder.
+	ULevelProgressTrackerSettings* CreateBenchmarkSettings();
+
+	/**
+	 * Creates and saves every benchmark level that does not exist yet. OnLevelSaved is called for each saved level
+	 * before it is released, to generate its database entry and collections.
+	 * Returns the number of generated levels.
+	 */
+	int32 GenerateBenchmarkLevels(TFunctionRef<void(UWorld*)> OnLevelSaved);
+}
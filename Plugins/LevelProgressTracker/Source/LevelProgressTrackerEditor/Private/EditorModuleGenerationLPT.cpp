@@ -13,14 +13,19 @@
 #include "LogLPTEditor.h"
 #include "SettingsLPT.h"
 
+#include "AssetRegistry/AssetData.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "Engine/Level.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 #include "UObject/Package.h"
 #include "UObject/SavePackage.h"
 #include "UObject/UObjectGlobals.h"
@@ -36,6 +41,7 @@ namespace EditorModuleLPTPrivate
 	const FName StyleSetName(TEXT("LevelProgressTrackerStyle"));
 	const FName ToolbarIconName(TEXT("LevelProgressTracker.LPTRules"));
 	const FName DefaultCollectionKey(TEXT("Default"));
+	const FName LearnedCollectionKey(TEXT("Learned"));
 
 	template <typename TAssetClass>
 	TAssetClass* LoadOrCreateDataAsset(const FString& PackagePath, const FString& AssetName, bool& bOutCreated)
@@ -151,6 +157,12 @@ namespace EditorModuleLPTPrivate
 		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.bUseExclusionMode));
 		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.bUseChunkedPreload));
 		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.PreloadChunkSize));
+		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.bUseAdaptiveChunkSize));
+		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.MinAdaptiveChunkSize));
+		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.MaxAdaptiveChunkSize));
+		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.TargetChunkLoadTime));
+		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.MaxChunksInFlight));
+		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.PreloadBackend));
 		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.bAllowWorldPartitionAutoScan));
 		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.bAllowWorldPartitionUnscopedAutoScan));
 
@@ -162,6 +174,26 @@ namespace EditorModuleLPTPrivate
 		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.AssetClassFilter.bIncludeWidgets));
 		Hash = HashCombineFast(Hash, GetTypeHash(FilterSettings.AssetClassFilter.bIncludeDataAssets));
 
+		const FLPTAssetTierRules& TierRules = FilterSettings.AssetTierRules;
+		Hash = HashCombineFast(Hash, GetTypeHash(TierRules.StaticMeshTier));
+		Hash = HashCombineFast(Hash, GetTypeHash(TierRules.SkeletalMeshTier));
+		Hash = HashCombineFast(Hash, GetTypeHash(TierRules.MaterialTier));
+		Hash = HashCombineFast(Hash, GetTypeHash(TierRules.NiagaraTier));
+		Hash = HashCombineFast(Hash, GetTypeHash(TierRules.SoundTier));
+		Hash = HashCombineFast(Hash, GetTypeHash(TierRules.WidgetTier));
+		Hash = HashCombineFast(Hash, GetTypeHash(TierRules.DataAssetTier));
+		Hash = HashCombineFast(Hash, GetTypeHash(TierRules.OtherTier));
+
+		for (const FSoftObjectPath& CriticalAsset : TierRules.CriticalAssets)
+		{
+			HashString(Hash, CriticalAsset.ToString());
+		}
+
+		for (const FSoftObjectPath& DeferredAsset : TierRules.DeferredAssets)
+		{
+			HashString(Hash, DeferredAsset.ToString());
+		}
+
 		for (const FSoftObjectPath& AssetRule : FilterSettings.AssetRules)
 		{
 			HashString(Hash, AssetRule.ToString());
@@ -686,9 +718,14 @@ namespace EditorModuleLPTPrivate
 
 		TSet<FSoftObjectPath> UniqueAssetPaths;
 		TArray<FSoftObjectPath> DeduplicatedAssetList;
+		TArray<int64> DeduplicatedCostWeights;
+		TArray<ELPTAssetPriorityTier> DeduplicatedTiers;
+		const bool bHasAssetTiers = !CollectionAsset->AssetTiers.IsEmpty();
 		DeduplicatedAssetList.Reserve(CollectionAsset->AssetList.Num());
-		for (const FSoftObjectPath& AssetPath : CollectionAsset->AssetList)
+		DeduplicatedCostWeights.Reserve(CollectionAsset->AssetList.Num());
+		for (int32 AssetIndex = 0; AssetIndex < CollectionAsset->AssetList.Num(); ++AssetIndex)
 		{
+			const FSoftObjectPath& AssetPath = CollectionAsset->AssetList[AssetIndex];
 			if (!AssetPath.IsValid() || UniqueAssetPaths.Contains(AssetPath))
 			{
 				bModified = true;
@@ -697,10 +734,17 @@ namespace EditorModuleLPTPrivate
 
 			UniqueAssetPaths.Add(AssetPath);
 			DeduplicatedAssetList.Add(AssetPath);
+			DeduplicatedCostWeights.Add(CollectionAsset->GetAssetCostWeight(AssetIndex));
+			if (bHasAssetTiers)
+			{
+				DeduplicatedTiers.Add(CollectionAsset->GetAssetPriorityTier(AssetIndex));
+			}
 		}
 		if (DeduplicatedAssetList.Num() != CollectionAsset->AssetList.Num())
 		{
 			CollectionAsset->AssetList = MoveTemp(DeduplicatedAssetList);
+			CollectionAsset->AssetCostWeights = MoveTemp(DeduplicatedCostWeights);
+			CollectionAsset->AssetTiers = MoveTemp(DeduplicatedTiers);
 		}
 
 		TSet<FSoftObjectPath> UniqueLayerAssets;
@@ -981,4 +1025,231 @@ namespace EditorModuleLPTPrivate
 		});
 		return FilteredAssets;
 	}
+
+	TArray<int64> BuildAssetCostWeights(IAssetRegistry& Registry, const TArray<FSoftObjectPath>& AssetList)
+	{
+		TArray<int64> CostWeights;
+		CostWeights.Reserve(AssetList.Num());
+
+		// The list already holds the hard dependency closure, so each package is charged only its own size.
+		// Further assets from an already charged package get the minimal weight.
+		TSet<FName> ChargedPackages;
+		ChargedPackages.Reserve(AssetList.Num());
+
+		for (const FSoftObjectPath& AssetPath : AssetList)
+		{
+			int64 CostWeight = 1;
+
+			const FName PackageName = AssetPath.GetLongPackageFName();
+			bool bAlreadyCharged = false;
+			ChargedPackages.Add(PackageName, &bAlreadyCharged);
+
+			if (!bAlreadyCharged)
+			{
+				const TOptional<FAssetPackageData> PackageData = Registry.GetAssetPackageDataCopy(PackageName);
+				if (PackageData.IsSet() && PackageData->DiskSize > 0)
+				{
+					CostWeight = PackageData->DiskSize;
+				}
+			}
+
+			CostWeights.Add(CostWeight);
+		}
+
+		return CostWeights;
+	}
+
+	TArray<ELPTAssetPriorityTier> BuildAssetPriorityTiers(IAssetRegistry& Registry, const TArray<FSoftObjectPath>& AssetList, const FLPTAssetTierRules& TierRules)
+	{
+		TArray<ELPTAssetPriorityTier> Tiers;
+		Tiers.Reserve(AssetList.Num());
+
+		bool bHasNonNormalTier = false;
+		for (const FSoftObjectPath& AssetPath : AssetList)
+		{
+			ELPTAssetPriorityTier Tier = ELPTAssetPriorityTier::Normal;
+
+			const FAssetData AssetData = Registry.GetAssetByObjectPath(AssetPath);
+			if (AssetData.IsValid())
+			{
+				Tier = AssetFilterLPT::ResolveAssetPriorityTier(AssetData, TierRules);
+			}
+			else if (TierRules.CriticalAssets.Contains(AssetPath))
+			{
+				Tier = ELPTAssetPriorityTier::Critical;
+			}
+			else if (TierRules.DeferredAssets.Contains(AssetPath))
+			{
+				Tier = ELPTAssetPriorityTier::Deferred;
+			}
+
+			bHasNonNormalTier |= Tier != ELPTAssetPriorityTier::Normal;
+			Tiers.Add(Tier);
+		}
+
+		// Keep collections without tier rules free of per-asset tier data.
+		if (!bHasNonNormalTier)
+		{
+			Tiers.Reset();
+		}
+
+		return Tiers;
+	}
+
+	bool LoadLearnedAssets(const FString& LevelPackagePath, TArray<FSoftObjectPath>& OutLearnedAssets)
+	{
+		OutLearnedAssets.Reset();
+
+		const FString FilePath = ULevelPreloadAssetFilter::GetLearnedAssetsFilePath(LevelPackagePath);
+		FString JsonText;
+		if (!FFileHelper::LoadFileToString(JsonText, *FilePath))
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> RootObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+		const TArray<TSharedPtr<FJsonValue>>* AssetValues = nullptr;
+		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid() || !RootObject->TryGetArrayField(TEXT("Assets"), AssetValues))
+		{
+			UE_LOG(LogLPTEditor, Warning, TEXT("Failed to parse learned assets file '%s'."), *FilePath);
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& AssetValue : *AssetValues)
+		{
+			FString AssetPath;
+			if (AssetValue.IsValid() && AssetValue->TryGetString(AssetPath))
+			{
+				const FSoftObjectPath LearnedAsset(AssetPath);
+				if (LearnedAsset.IsValid())
+				{
+					OutLearnedAssets.Add(LearnedAsset);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool LoadOverfetchUnusedAssets(const FString& LevelPackagePath, TArray<FSoftObjectPath>& OutUnusedAssets, FString& OutReportPath)
+	{
+		OutUnusedAssets.Reset();
+		OutReportPath.Reset();
+
+		// Report names end with a sortable timestamp, the last one is the latest.
+		const FString ReportPattern = ULevelPreloadAssetFilter::GetOverfetchReportFilePath(LevelPackagePath, TEXT("*"));
+		TArray<FString> ReportFileNames;
+		IFileManager::Get().FindFiles(ReportFileNames, *ReportPattern, true, false);
+		if (ReportFileNames.IsEmpty())
+		{
+			return false;
+		}
+
+		ReportFileNames.Sort();
+		OutReportPath = FPaths::GetPath(ReportPattern) / ReportFileNames.Last();
+
+		FString JsonText;
+		if (!FFileHelper::LoadFileToString(JsonText, *OutReportPath))
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> RootObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+		const TArray<TSharedPtr<FJsonValue>>* CollectionValues = nullptr;
+		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid() || !RootObject->TryGetArrayField(TEXT("Collections"), CollectionValues))
+		{
+			UE_LOG(LogLPTEditor, Warning, TEXT("Failed to parse overfetch report '%s'."), *OutReportPath);
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& CollectionValue : *CollectionValues)
+		{
+			const TSharedPtr<FJsonObject>* CollectionObject = nullptr;
+			const TArray<TSharedPtr<FJsonValue>>* UnusedPathValues = nullptr;
+			if (!CollectionValue.IsValid() || !CollectionValue->TryGetObject(CollectionObject) || !(*CollectionObject)->TryGetArrayField(TEXT("UnusedPaths"), UnusedPathValues))
+			{
+				continue;
+			}
+
+			for (const TSharedPtr<FJsonValue>& UnusedPathValue : *UnusedPathValues)
+			{
+				FString AssetPath;
+				if (UnusedPathValue.IsValid() && UnusedPathValue->TryGetString(AssetPath))
+				{
+					const FSoftObjectPath UnusedAsset(AssetPath);
+					if (UnusedAsset.IsValid())
+					{
+						OutUnusedAssets.AddUnique(UnusedAsset);
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	int32 MergeLearnedAssetsIntoCollection(
+		const ULevelProgressTrackerSettings* Settings,
+		const FString& LevelAssetName,
+		const TArray<FSoftObjectPath>& LearnedAssets,
+		IAssetRegistry& Registry,
+		const FLPTFilterSettings& BaseRules,
+		const bool bIsWorldPartition,
+		FLevelPreloadEntryLPT& InOutEntry)
+	{
+		UAssetCollectionDataLPT* CollectionAsset = GetOrCreateCollectionAsset(Settings, LevelAssetName, LearnedCollectionKey);
+		if (!CollectionAsset)
+		{
+			return INDEX_NONE;
+		}
+
+		CollectionAsset->Modify();
+
+		// Learned lists are maintained by record mode, auto generation would overwrite them on level save.
+		CollectionAsset->bAutoGenerate = false;
+
+		TSet<FSoftObjectPath> ExistingAssets(CollectionAsset->AssetList);
+		int32 AddedAssetCount = 0;
+		for (const FSoftObjectPath& LearnedAsset : LearnedAssets)
+		{
+			// Assets deleted since the recording are skipped.
+			if (!ExistingAssets.Contains(LearnedAsset) && Registry.GetAssetByObjectPath(LearnedAsset).IsValid())
+			{
+				ExistingAssets.Add(LearnedAsset);
+				CollectionAsset->AssetList.Add(LearnedAsset);
+				++AddedAssetCount;
+			}
+		}
+
+		// Kept in merge order, weights and tiers are rebuilt for the sorted list.
+		CollectionAsset->AssetLoadOrderKeys.Reset();
+		CollectionAsset->AssetList.Sort(&UAssetCollectionDataLPT::AssetPathLess);
+
+		const FLPTFilterSettings CollectionRules = BuildCollectionEffectiveRules(BaseRules, CollectionAsset, bIsWorldPartition);
+		CollectionAsset->AssetCostWeights = BuildAssetCostWeights(Registry, CollectionAsset->AssetList);
+		CollectionAsset->AssetTiers = BuildAssetPriorityTiers(Registry, CollectionAsset->AssetList, CollectionRules.AssetTierRules);
+		CollectionAsset->CollectionContentHash = ComputeCollectionContentHash(CollectionAsset, CollectionRules);
+
+		CollectionAsset->MarkPackageDirty();
+		CollectionAsset->GetOutermost()->MarkPackageDirty();
+		if (!SaveAssetObject(CollectionAsset))
+		{
+			UE_LOG(LogLPTEditor, Warning, TEXT("Failed to save collection asset '%s'."), *CollectionAsset->GetPathName());
+		}
+
+		const FSoftObjectPath CollectionPath(CollectionAsset->GetPathName());
+		const bool bExistsInEntry = InOutEntry.Collections.ContainsByPredicate([&CollectionPath](const TSoftObjectPtr<UAssetCollectionDataLPT>& CollectionRef)
+		{
+			return CollectionRef.ToSoftObjectPath() == CollectionPath;
+		});
+
+		if (!bExistsInEntry)
+		{
+			InOutEntry.Collections.Add(CollectionAsset);
+		}
+
+		return AddedAssetCount;
+	}
 }
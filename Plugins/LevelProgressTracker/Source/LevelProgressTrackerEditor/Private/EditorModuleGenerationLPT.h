@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SettingsLPT.h"
 
 class IAssetRegistry;
 class UObject;
@@ -11,7 +12,6 @@ class UAssetFilterSettingsLPT;
 class UDataLayerAsset;
 class ULevelProgressTrackerSettings;
 class UWorld;
-struct FLPTFilterSettings;
 struct FLevelPreloadEntryLPT;
 
 namespace EditorModuleLPTPrivate
@@ -19,6 +19,7 @@ namespace EditorModuleLPTPrivate
 	extern const FName StyleSetName;
 	extern const FName ToolbarIconName;
 	extern const FName DefaultCollectionKey;
+	extern const FName LearnedCollectionKey;
 
 	uint32 ComputeCollectionContentHash(const UAssetCollectionDataLPT* CollectionAsset, const FLPTFilterSettings& EffectiveFilterSettings);
 	uint32 ComputeLevelStateHash(UWorld* SavedWorld, const FLPTFilterSettings& EffectiveFilterSettings);
@@ -37,4 +38,25 @@ namespace EditorModuleLPTPrivate
 
 	FLPTFilterSettings BuildCollectionEffectiveRules(const FLPTFilterSettings& BaseRules, const UAssetCollectionDataLPT* CollectionAsset, bool bIsWorldPartition);
 	TArray<FSoftObjectPath> BuildFilteredAssetsForRules(UWorld* SavedWorld, IAssetRegistry& Registry, const FLPTFilterSettings& EffectiveRules);
+	TArray<int64> BuildAssetCostWeights(IAssetRegistry& Registry, const TArray<FSoftObjectPath>& AssetList);
+	TArray<ELPTAssetPriorityTier> BuildAssetPriorityTiers(IAssetRegistry& Registry, const TArray<FSoftObjectPath>& AssetList, const FLPTAssetTierRules& TierRules);
+
+	// Reads assets recorded by runtime record mode for the level from Saved/LPT/Learned.
+	bool LoadLearnedAssets(const FString& LevelPackagePath, TArray<FSoftObjectPath>& OutLearnedAssets);
+
+	// Reads unused assets from the latest overfetch analysis report of the level in Saved/LPT/Overfetch.
+	bool LoadOverfetchUnusedAssets(const FString& LevelPackagePath, TArray<FSoftObjectPath>& OutUnusedAssets, FString& OutReportPath);
+
+	/**
+	 * Adds learned assets to the manual "Learned" collection of the level and adds the collection to the entry.
+	 * Returns the number of added assets, or INDEX_NONE if the collection could not be created.
+	 */
+	int32 MergeLearnedAssetsIntoCollection(
+		const ULevelProgressTrackerSettings* Settings,
+		const FString& LevelAssetName,
+		const TArray<FSoftObjectPath>& LearnedAssets,
+		IAssetRegistry& Registry,
+		const FLPTFilterSettings& BaseRules,
+		bool bIsWorldPartition,
+		FLevelPreloadEntryLPT& InOutEntry);
 }
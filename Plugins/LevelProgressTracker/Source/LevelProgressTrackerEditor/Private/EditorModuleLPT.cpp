@@ -5,6 +5,7 @@
 #include "EditorModuleGenerationLPT.h"
 
 #include "AssetUtilsLPT.h"
+#include "BenchmarkContentLPT.h"
 #include "DatabaseLPT.h"
 #include "LevelPreloadAssetFilter.h"
 #include "LevelPreloadDatabaseLPT.h"
@@ -14,11 +15,13 @@
 #include "SettingsLPT.h"
 #include "SlateWidgetLPT.h"
 
+#include "Algo/IsSorted.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Brushes/SlateImageBrush.h"
 #include "Editor.h"
 #include "Engine/World.h"
 #include "Framework/Commands/UIAction.h"
+#include "HAL/IConsoleManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/MessageDialog.h"
 #include "Misc/PackageName.h"
@@ -40,6 +43,12 @@ void FLevelProgressTrackerEditorModule::StartupModule()
 	ULevelProgressTrackerSettings::OnOpenLevelRulesEditorRequested.AddRaw(this, &FLevelProgressTrackerEditorModule::HandleOpenLevelRulesEditorRequested);
 	RegisterMenus();
 	UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FLevelProgressTrackerEditorModule::RegisterMenus));
+	GenerateBenchmarkContentCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("LPT.GenerateBenchmarkContent"),
+		TEXT("Generates the levels of the LPT.Benchmark automation test under /LevelProgressTracker/Benchmark."),
+		FConsoleCommandDelegate::CreateRaw(this, &FLevelProgressTrackerEditorModule::HandleGenerateBenchmarkContent),
+		ECVF_Default
+	);
 #endif
 }
 
@@ -49,9 +58,16 @@ void FLevelProgressTrackerEditorModule::ShutdownModule()
 	UE_LOG(LogLPTEditor, Log, TEXT("ShutdownModule."));
 	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
 	ULevelProgressTrackerSettings::OnOpenLevelRulesEditorRequested.RemoveAll(this);
+	if (GenerateBenchmarkContentCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(GenerateBenchmarkContentCommand);
+		GenerateBenchmarkContentCommand = nullptr;
+	}
 	if (UToolMenus::TryGet())
 	{
 		UToolMenus::Get()->RemoveEntry(TEXT("LevelEditor.LevelEditorToolBar.AssetsToolBar"), TEXT("Content"), TEXT("LPT_OpenLevelRules"));
+		UToolMenus::Get()->RemoveEntry(TEXT("LevelEditor.LevelEditorToolBar.AssetsToolBar"), TEXT("Content"), TEXT("LPT_MergeLearnedAssets"));
+		UToolMenus::Get()->RemoveEntry(TEXT("LevelEditor.LevelEditorToolBar.AssetsToolBar"), TEXT("Content"), TEXT("LPT_ImportOverfetch"));
 		UToolMenus::UnRegisterStartupCallback(this);
 		UToolMenus::UnregisterOwner(this);
 	}
@@ -120,6 +136,8 @@ void FLevelProgressTrackerEditorModule::RegisterMenus()
 	}
 
 	ToolMenus->RemoveEntry(TEXT("LevelEditor.LevelEditorToolBar.AssetsToolBar"), TEXT("Content"), TEXT("LPT_OpenLevelRules"));
+	ToolMenus->RemoveEntry(TEXT("LevelEditor.LevelEditorToolBar.AssetsToolBar"), TEXT("Content"), TEXT("LPT_MergeLearnedAssets"));
+	ToolMenus->RemoveEntry(TEXT("LevelEditor.LevelEditorToolBar.AssetsToolBar"), TEXT("Content"), TEXT("LPT_ImportOverfetch"));
 
 	FToolMenuSection& Section = ToolbarMenu->FindOrAddSection(TEXT("Content"));
 	FToolMenuEntry Entry = FToolMenuEntry::InitToolBarButton(
@@ -136,7 +154,35 @@ void FLevelProgressTrackerEditorModule::RegisterMenus()
 	Entry.InsertPosition = FToolMenuInsert(TEXT("EditCinematics"), EToolMenuInsertType::After);
 	Section.AddEntry(Entry);
 
-	UE_LOG(LogLPTEditor, Log, TEXT("Registered toolbar button 'LPT Rules'."));
+	FToolMenuEntry LearnedEntry = FToolMenuEntry::InitToolBarButton(
+		TEXT("LPT_MergeLearnedAssets"),
+		FUIAction(FExecuteAction::CreateRaw(this, &FLevelProgressTrackerEditorModule::HandleToolbarMergeLearnedAssetsClicked)),
+		FText::FromString(TEXT("LPT Learned")),
+		FText::FromString(TEXT("Merge assets recorded by LPT record mode for the currently opened level into its Learned collection.")),
+		FSlateIcon(
+			EditorModuleLPTPrivate::StyleSetName,
+			EditorModuleLPTPrivate::ToolbarIconName,
+			TEXT("LevelProgressTracker.LPTRules.Small")
+		)
+	);
+	LearnedEntry.InsertPosition = FToolMenuInsert(TEXT("LPT_OpenLevelRules"), EToolMenuInsertType::After);
+	Section.AddEntry(LearnedEntry);
+
+	FToolMenuEntry OverfetchEntry = FToolMenuEntry::InitToolBarButton(
+		TEXT("LPT_ImportOverfetch"),
+		FUIAction(FExecuteAction::CreateRaw(this, &FLevelProgressTrackerEditorModule::HandleToolbarImportOverfetchClicked)),
+		FText::FromString(TEXT("LPT Overfetch")),
+		FText::FromString(TEXT("Import unused assets from the latest LPT overfetch analysis report of the currently opened level into SuggestedAssetExclusions of its filter settings.")),
+		FSlateIcon(
+			EditorModuleLPTPrivate::StyleSetName,
+			EditorModuleLPTPrivate::ToolbarIconName,
+			TEXT("LevelProgressTracker.LPTRules.Small")
+		)
+	);
+	OverfetchEntry.InsertPosition = FToolMenuInsert(TEXT("LPT_MergeLearnedAssets"), EToolMenuInsertType::After);
+	Section.AddEntry(OverfetchEntry);
+
+	UE_LOG(LogLPTEditor, Log, TEXT("Registered toolbar buttons 'LPT Rules', 'LPT Learned' and 'LPT Overfetch'."));
 	ToolMenus->RefreshAllWidgets();
 }
 
@@ -146,13 +192,158 @@ void FLevelProgressTrackerEditorModule::HandleToolbarOpenLevelRulesClicked()
 	HandleOpenLevelRulesEditorRequested(GetMutableDefault<ULevelProgressTrackerSettings>());
 }
 
+void FLevelProgressTrackerEditorModule::HandleToolbarMergeLearnedAssetsClicked()
+{
+	const auto ShowDialog = [](const FString& Message)
+	{
+		UE_LOG(LogLPTEditor, Log, TEXT("%s"), *Message);
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+	};
+
+	const ULevelProgressTrackerSettings* Settings = GetDefault<ULevelProgressTrackerSettings>();
+
+	TSoftObjectPtr<UWorld> LevelSoftPtr;
+	FString LevelPackagePath;
+	FString LevelDisplayName;
+	bool bIsWorldPartition = false;
+	if (!TryGetCurrentEditorLevel(LevelSoftPtr, LevelPackagePath, LevelDisplayName, bIsWorldPartition))
+	{
+		ShowDialog(TEXT("Failed to resolve the currently opened level."));
+		return;
+	}
+
+	TArray<FSoftObjectPath> LearnedAssets;
+	if (!EditorModuleLPTPrivate::LoadLearnedAssets(LevelPackagePath, LearnedAssets) || LearnedAssets.IsEmpty())
+	{
+		ShowDialog(FString::Printf(TEXT("No learned assets were recorded for level '%s'. Enable Record Missing Assets in project settings and play the level first."), *LevelPackagePath));
+		return;
+	}
+
+	ULevelPreloadDatabaseLPT* DatabaseAsset = GetOrCreateDatabaseAsset(Settings);
+	if (!DatabaseAsset)
+	{
+		ShowDialog(TEXT("Failed to create or load LevelPreloadDatabaseLPT asset."));
+		return;
+	}
+
+	bool bWasEntryAdded = false;
+	FLevelPreloadEntryLPT* Entry = DatabaseAsset->FindOrAddEntryByLevel(LevelSoftPtr, bWasEntryAdded);
+	if (!Entry)
+	{
+		ShowDialog(FString::Printf(TEXT("Failed to create or resolve database entry for '%s'."), *LevelPackagePath));
+		return;
+	}
+
+	DatabaseAsset->Modify();
+
+	const UAssetFilterSettingsLPT* FilterSettingsAsset = Entry->FilterSettings.LoadSynchronous();
+	const FLPTFilterSettings BaseRules = FilterSettingsAsset ? FilterSettingsAsset->ToFilterSettings() : FLPTFilterSettings();
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	const int32 AddedAssetCount = EditorModuleLPTPrivate::MergeLearnedAssetsIntoCollection(
+		Settings,
+		LevelDisplayName,
+		LearnedAssets,
+		AssetRegistryModule.Get(),
+		BaseRules,
+		bIsWorldPartition,
+		*Entry
+	);
+
+	if (AddedAssetCount == INDEX_NONE)
+	{
+		ShowDialog(FString::Printf(TEXT("Failed to create the Learned collection asset for level '%s'."), *LevelPackagePath));
+		return;
+	}
+
+	DatabaseAsset->MarkPackageDirty();
+	DatabaseAsset->GetOutermost()->MarkPackageDirty();
+	SaveDatabaseAsset(DatabaseAsset);
+
+	ShowDialog(FString::Printf(TEXT("Merged %d new learned assets into the Learned collection of level '%s'."), AddedAssetCount, *LevelPackagePath));
+}
+
+void FLevelProgressTrackerEditorModule::HandleToolbarImportOverfetchClicked()
+{
+	const auto ShowDialog = [](const FString& Message)
+	{
+		UE_LOG(LogLPTEditor, Log, TEXT("%s"), *Message);
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message));
+	};
+
+	const ULevelProgressTrackerSettings* Settings = GetDefault<ULevelProgressTrackerSettings>();
+
+	TSoftObjectPtr<UWorld> LevelSoftPtr;
+	FString LevelPackagePath;
+	FString LevelDisplayName;
+	bool bIsWorldPartition = false;
+	if (!TryGetCurrentEditorLevel(LevelSoftPtr, LevelPackagePath, LevelDisplayName, bIsWorldPartition))
+	{
+		ShowDialog(TEXT("Failed to resolve the currently opened level."));
+		return;
+	}
+
+	TArray<FSoftObjectPath> UnusedAssets;
+	FString ReportPath;
+	if (!EditorModuleLPTPrivate::LoadOverfetchUnusedAssets(LevelPackagePath, UnusedAssets, ReportPath))
+	{
+		ShowDialog(FString::Printf(TEXT("No overfetch report was found for level '%s'. Enable Analyze Preload Overfetch in project settings and play the level first."), *LevelPackagePath));
+		return;
+	}
+
+	ULevelPreloadDatabaseLPT* DatabaseAsset = GetOrCreateDatabaseAsset(Settings);
+	const FLevelPreloadEntryLPT* Entry = DatabaseAsset ? DatabaseAsset->FindEntryByLevel(LevelSoftPtr) : nullptr;
+	UAssetFilterSettingsLPT* FilterSettingsAsset = Entry ? Entry->FilterSettings.LoadSynchronous() : nullptr;
+	if (!FilterSettingsAsset)
+	{
+		ShowDialog(FString::Printf(TEXT("Filter settings of level '%s' were not found. Save the level to generate them first."), *LevelPackagePath));
+		return;
+	}
+
+	FilterSettingsAsset->Modify();
+	int32 AddedAssetCount = 0;
+	for (const FSoftObjectPath& UnusedAsset : UnusedAssets)
+	{
+		if (!FilterSettingsAsset->SuggestedAssetExclusions.Contains(UnusedAsset))
+		{
+			FilterSettingsAsset->SuggestedAssetExclusions.Add(UnusedAsset);
+			++AddedAssetCount;
+		}
+	}
+
+	if (AddedAssetCount > 0)
+	{
+		FilterSettingsAsset->MarkPackageDirty();
+		if (!EditorModuleLPTPrivate::SaveAssetObject(FilterSettingsAsset))
+		{
+			ShowDialog(FString::Printf(TEXT("Failed to save filter settings asset '%s'."), *FilterSettingsAsset->GetPathName()));
+			return;
+		}
+	}
+
+	ShowDialog(FString::Printf(TEXT("Imported %d new suggested exclusions for level '%s' from '%s'."), AddedAssetCount, *LevelPackagePath, *ReportPath));
+}
+
+void FLevelProgressTrackerEditorModule::HandleGenerateBenchmarkContent()
+{
+	const ULevelProgressTrackerSettings* BenchmarkSettings = BenchmarkContentLPT::CreateBenchmarkSettings();
+
+	TGuardValue<bool> GeneratingGuard(bGeneratingBenchmarkContent, true);
+	const int32 GeneratedLevelCount = BenchmarkContentLPT::GenerateBenchmarkLevels([this, BenchmarkSettings](UWorld* SavedWorld)
+		{
+			RebuildLevelDependencies(SavedWorld, BenchmarkSettings);
+		});
+
+	UE_LOG(LogLPTEditor, Log, TEXT("Generated %d benchmark levels."), GeneratedLevelCount);
+}
+
 void FLevelProgressTrackerEditorModule::OnPackageSaved(const FString& PackageFilename, UPackage* SavedPackage, FObjectPostSaveContext SaveContext)
 {
 	(void)PackageFilename;
 	(void)SaveContext;
 
 	const ULevelProgressTrackerSettings* Settings = GetDefault<ULevelProgressTrackerSettings>();
-	if (Settings && !Settings->bAutoGenerateOnLevelSave)
+	if ((Settings && !Settings->bAutoGenerateOnLevelSave) || bGeneratingBenchmarkContent)
 	{
 		return;
 	}
@@ -243,14 +434,14 @@ bool FLevelProgressTrackerEditorModule::TryGetCurrentEditorLevel(TSoftObjectPtr<
 	return true;
 }
 
-void FLevelProgressTrackerEditorModule::RebuildLevelDependencies(UWorld* SavedWorld)
+void FLevelProgressTrackerEditorModule::RebuildLevelDependencies(UWorld* SavedWorld, const ULevelProgressTrackerSettings* SettingsOverride)
 {
 	if (!SavedWorld)
 	{
 		return;
 	}
 
-	const ULevelProgressTrackerSettings* Settings = GetDefault<ULevelProgressTrackerSettings>();
+	const ULevelProgressTrackerSettings* Settings = SettingsOverride ? SettingsOverride : GetDefault<ULevelProgressTrackerSettings>();
 	if (!Settings)
 	{
 		UE_LOG(LogLPTEditor, Warning, TEXT("Project settings are not available. Skipping database generation."));
@@ -354,11 +545,12 @@ void FLevelProgressTrackerEditorModule::RebuildLevelDependencies(UWorld* SavedWo
 
 		if (CollectionAsset->bAutoGenerate)
 		{
-			const TArray<FSoftObjectPath> GeneratedAssetList = EditorModuleLPTPrivate::BuildFilteredAssetsForRules(
+			TArray<FSoftObjectPath> GeneratedAssetList = EditorModuleLPTPrivate::BuildFilteredAssetsForRules(
 				SavedWorld,
 				Registry,
 				CollectionRules
 			);
+			GeneratedAssetList.Sort(&UAssetCollectionDataLPT::AssetPathLess);
 
 			if (CollectionAsset->AssetList != GeneratedAssetList)
 			{
@@ -367,6 +559,30 @@ void FLevelProgressTrackerEditorModule::RebuildLevelDependencies(UWorld* SavedWo
 			}
 		}
 
+		// Sorted lists are merged at runtime in one pass instead of through a hash set. Weights and tiers follow below.
+		// Load order keys are left over from a cook in this editor session, the cook applies them again.
+		if (!CollectionAsset->AssetLoadOrderKeys.IsEmpty() || !Algo::IsSorted(CollectionAsset->AssetList, &UAssetCollectionDataLPT::AssetPathLess))
+		{
+			CollectionAsset->AssetLoadOrderKeys.Reset();
+			CollectionAsset->AssetList.Sort(&UAssetCollectionDataLPT::AssetPathLess);
+			bCollectionModified = true;
+		}
+
+		// Weights are refreshed for manual lists too, package sizes change when dependencies are resaved.
+		const TArray<int64> GeneratedCostWeights = EditorModuleLPTPrivate::BuildAssetCostWeights(Registry, CollectionAsset->AssetList);
+		if (CollectionAsset->AssetCostWeights != GeneratedCostWeights)
+		{
+			CollectionAsset->AssetCostWeights = GeneratedCostWeights;
+			bCollectionModified = true;
+		}
+
+		const TArray<ELPTAssetPriorityTier> GeneratedTiers = EditorModuleLPTPrivate::BuildAssetPriorityTiers(Registry, CollectionAsset->AssetList, CollectionRules.AssetTierRules);
+		if (CollectionAsset->AssetTiers != GeneratedTiers)
+		{
+			CollectionAsset->AssetTiers = GeneratedTiers;
+			bCollectionModified = true;
+		}
+
 		const uint32 NewCollectionHash = EditorModuleLPTPrivate::ComputeCollectionContentHash(CollectionAsset, CollectionRules);
 		if (CollectionAsset->CollectionContentHash != NewCollectionHash)
 		{
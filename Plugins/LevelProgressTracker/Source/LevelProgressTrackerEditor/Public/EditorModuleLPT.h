@@ -11,6 +11,7 @@ class ULevelPreloadDatabaseLPT;
 class ULevelProgressTrackerSettings;
 class FObjectPostSaveContext;
 class FSlateStyleSet;
+class IConsoleObject;
 
 class FLevelProgressTrackerEditorModule : public IModuleInterface
 {
@@ -23,9 +24,12 @@ private:
 	void RegisterStyle();
 	void UnregisterStyle();
 	void OnPackageSaved(const FString& PackageFilename, UPackage* SavedPackage, FObjectPostSaveContext SaveContext);
-	void RebuildLevelDependencies(UWorld* SavedWorld);
+	void RebuildLevelDependencies(UWorld* SavedWorld, const ULevelProgressTrackerSettings* SettingsOverride = nullptr);
 	void RegisterMenus();
 	void HandleToolbarOpenLevelRulesClicked();
+	void HandleToolbarMergeLearnedAssetsClicked();
+	void HandleToolbarImportOverfetchClicked();
+	void HandleGenerateBenchmarkContent();
 	void HandleOpenLevelRulesEditorRequested(ULevelProgressTrackerSettings* Settings);
 	bool TryGetCurrentEditorLevel(TSoftObjectPtr<UWorld>& OutLevelSoftPtr, FString& OutLevelPackagePath, FString& OutLevelDisplayName, bool& bIsWorldPartition) const;
 	void OpenLevelRulesWindow(ULevelPreloadDatabaseLPT* DatabaseAsset, const TSoftObjectPtr<UWorld>& LevelSoftPtr, const FString& LevelDisplayName, bool bIsWorldPartition);
@@ -33,5 +37,8 @@ private:
 	bool SaveDatabaseAsset(ULevelPreloadDatabaseLPT* DatabaseAsset) const;
 
 	TSharedPtr<FSlateStyleSet> StyleSet;
+	IConsoleObject* GenerateBenchmarkContentCommand = nullptr;
+	// Benchmark levels generate their entries with their own settings instead of the level save hook.
+	bool bGeneratingBenchmarkContent = false;
 #endif
 };